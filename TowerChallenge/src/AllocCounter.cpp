@@ -0,0 +1,70 @@
+#include "AllocCounter.h"
+
+#ifndef NDEBUG
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> gAllocCount{0};
+
+static void* countedAlloc(std::size_t size) {
+    gAllocCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+static void* countedAlignedAlloc(std::size_t size, std::align_val_t align) {
+    gAllocCount.fetch_add(1, std::memory_order_relaxed);
+    std::size_t a = std::size_t(align);
+    if (a < sizeof(void*)) a = sizeof(void*);
+    // Tự căn lề: lưu con trỏ gốc ngay trước vùng trả về
+    void* raw = std::malloc(size + a + sizeof(void*));
+    if (!raw) return nullptr;
+    std::uintptr_t p = (std::uintptr_t(raw) + sizeof(void*) + a - 1) & ~std::uintptr_t(a - 1);
+    reinterpret_cast<void**>(p)[-1] = raw;
+    return reinterpret_cast<void*>(p);
+}
+
+static void alignedFree(void* p) {
+    if (p) std::free(reinterpret_cast<void**>(p)[-1]);
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new(std::size_t size, std::align_val_t align) {
+    if (void* p = countedAlignedAlloc(size, align)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+    if (void* p = countedAlignedAlloc(size, align)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+
+bool allocCounterEnabled() { return true; }
+uint64_t allocCount() { return gAllocCount.load(std::memory_order_relaxed); }
+
+#else
+
+bool allocCounterEnabled() { return false; }
+uint64_t allocCount() { return 0; }
+
+#endif
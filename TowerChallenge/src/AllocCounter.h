@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstdint>
+
+// Đếm số lần cấp phát heap qua operator new toàn cục. Chỉ bật ở bản debug
+// (không định nghĩa NDEBUG); ở bản release allocCount() luôn trả về 0.
+
+bool allocCounterEnabled();
+uint64_t allocCount();
@@ -0,0 +1,152 @@
+#include "AssetLoader.h"
+
+#include <SDL2/SDL_image.h>
+
+#include <cstdio>
+
+#include "ImageScale.h"
+#include "Trace.h"
+
+const int ASSET_LOADER_THREADS = 4;
+
+
+AssetJob* addAssetJob(AssetLoader& loader, const char* name, AssetKind kind, void* target,
+                      bool menuRequired) {
+    if (loader.jobCount >= ASSET_LOADER_MAX_JOBS) return nullptr;
+    AssetJob& job = loader.jobs[loader.jobCount++];
+    job.name = name;
+    job.kind = kind;
+    job.target = target;
+    job.menuRequired = menuRequired;
+    return &job;
+}
+
+// Chạy trên worker: chỉ đọc file và giải mã, không đụng tới renderer
+static void decodeAsset(AssetJob& job, const AssetPack* pack) {
+    TRACE_SCOPE(job.name);
+    char path[256];
+    snprintf(path, sizeof(path), "assets/%s", job.name);
+
+    bool ok = true;
+    switch (job.kind) {
+    case AssetKind::TEXTURE:
+        // Ảnh có trong gói được upload thẳng từ vùng map ở luồng chính
+        if (!pack || !findPackEntry(*pack, job.name)) {
+            job.surface = job.decodeSurface ? job.decodeSurface("assets")
+                                            : loadImageScaled(path, job.width, job.height);
+            ok = job.surface != nullptr;
+            if (!ok) SDL_Log("Failed to load %s: %s", path, IMG_GetError());
+        }
+        break;
+    case AssetKind::CHUNK:
+        job.result = pack ? packChunk(*pack, job.name) : nullptr;
+        if (!job.result) job.result = Mix_LoadWAV(path);
+        ok = job.result != nullptr;
+        if (!ok) SDL_Log("Failed to load %s: %s", path, Mix_GetError());
+        break;
+    case AssetKind::MUSIC:
+        job.result = Mix_LoadMUS(path);
+        ok = job.result != nullptr;
+        if (!ok) SDL_Log("Failed to load music %s: %s", path, Mix_GetError());
+        break;
+    case AssetKind::FONT:
+        job.result = TTF_OpenFont(path, job.fontSize);
+        ok = job.result != nullptr;
+        if (!ok) SDL_Log("Failed to load font %s: %s", path, TTF_GetError());
+        break;
+    }
+    job.state.store(ok ? ASSET_DECODED : ASSET_FAILED, std::memory_order_release);
+}
+
+void startAssetLoader(AssetLoader& loader, const AssetPack* pack, TextureManager& textures) {
+    loader.pack = (pack && pack->data) ? pack : nullptr;
+    loader.textures = &textures;
+    loader.startCounter = SDL_GetPerformanceCounter();
+    loader.pool.reset(new JobPool(ASSET_LOADER_THREADS));
+    for (int i = 0; i < loader.jobCount; i++) {
+        AssetJob* job = &loader.jobs[i];
+        const AssetPack* p = loader.pack;
+        loader.pool->submit([job, p] { decodeAsset(*job, p); });
+    }
+}
+
+
+static void freeDecoded(AssetJob& job) {
+    if (job.surface) SDL_FreeSurface(job.surface);
+    job.surface = nullptr;
+    if (!job.result) return;
+    switch (job.kind) {
+    case AssetKind::CHUNK: Mix_FreeChunk((Mix_Chunk*)job.result); break;
+    case AssetKind::MUSIC: Mix_FreeMusic((Mix_Music*)job.result); break;
+    case AssetKind::FONT:  TTF_CloseFont((TTF_Font*)job.result); break;
+    case AssetKind::TEXTURE: break;
+    }
+    job.result = nullptr;
+}
+
+bool pumpAssetLoader(AssetLoader& loader) {
+    if (loader.finished == loader.jobCount) return true;
+
+    for (int i = 0; i < loader.jobCount; i++) {
+        AssetJob& job = loader.jobs[i];
+        int state = job.state.load(std::memory_order_acquire);
+        if (state == ASSET_FAILED) {
+            job.state.store(ASSET_DONE, std::memory_order_relaxed);
+            loader.finished++;
+            loader.failed++;
+            continue;
+        }
+        if (state != ASSET_DECODED) continue;
+
+        TRACE_SCOPE("assetUpload");
+        bool ok = true;
+        if (job.kind == AssetKind::TEXTURE) {
+            SDL_Renderer* renderer = loader.textures->renderer;
+            SDL_Texture* tex = job.surface ? SDL_CreateTextureFromSurface(renderer, job.surface)
+                                           : packTexture(renderer, *loader.pack, job.name);
+            if (job.surface) SDL_FreeSurface(job.surface);
+            job.surface = nullptr;
+            // Ảnh trong assets/ nạp lại được nên được phép evict khi vượt budget
+            if (tex) SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+            TextureHandle h = adoptTexture(*loader.textures, tex, job.name, job.reloadable);
+            ok = h != NO_TEXTURE;
+            if (ok) *(TextureHandle*)job.target = h;
+            else SDL_Log("Failed to create texture %s: %s", job.name, SDL_GetError());
+        } else {
+            *(void**)job.target = job.result;
+            job.result = nullptr;
+        }
+        job.state.store(ASSET_DONE, std::memory_order_relaxed);
+        loader.finished++;
+        if (ok && job.onReady) ok = job.onReady();
+        if (!ok) loader.failed++;
+    }
+
+    if (loader.finished < loader.jobCount) return false;
+    SDL_Log("All assets loaded in %.1f ms",
+            (SDL_GetPerformanceCounter() - loader.startCounter) * 1000.0 / SDL_GetPerformanceFrequency());
+    // Worker không còn việc: dừng pool ngay, không giữ luồng tới lúc thoát
+    loader.pool.reset();
+    return true;
+}
+
+bool menuAssetsReady(const AssetLoader& loader) {
+    for (int i = 0; i < loader.jobCount; i++) {
+        const AssetJob& job = loader.jobs[i];
+        if (job.menuRequired && job.state.load(std::memory_order_relaxed) != ASSET_DONE) return false;
+    }
+    return true;
+}
+
+float assetLoaderProgress(const AssetLoader& loader) {
+    return loader.jobCount ? float(loader.finished) / loader.jobCount : 1.0f;
+}
+
+
+void finishAssetLoader(AssetLoader& loader) {
+    if (loader.pool) {
+        loader.pool->wait();
+        loader.pool.reset();
+    }
+    for (int i = 0; i < loader.jobCount; i++) freeDecoded(loader.jobs[i]);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <atomic>
+#include <memory>
+
+#include "AssetPack.h"
+#include "TextureManager.h"
+#include "core/JobPool.h"
+
+// Nạp tài nguyên bất đồng bộ: đọc file và giải mã PNG/JPEG/MP3 chạy song song
+// trên các luồng worker; luồng chính chỉ upload texture lên GPU (gọi
+// pumpAssetLoader mỗi frame) và gán kết quả vào con trỏ đích.
+// Tài nguyên đánh dấu menuRequired phải xong trước khi menu nhận input; phần
+// còn lại (chỉ dùng khi chơi) được phép về sau.
+
+enum class AssetKind { TEXTURE, CHUNK, MUSIC, FONT };
+
+const int ASSET_LOADER_MAX_JOBS = 16;
+
+struct AssetJob {
+    const char* name = nullptr;      // đường dẫn trong assets/
+    AssetKind kind = AssetKind::TEXTURE;
+    bool menuRequired = false;
+    int fontSize = 0;
+    int width = 0;                   // ảnh: kích thước vẽ để thu nhỏ lúc nạp, 0 = giữ nguyên
+    int height = 0;
+    bool reloadable = true;          // ảnh: cho TextureManager evict rồi nạp lại
+    SDL_Surface* (*decodeSurface)(const char* assetsDir) = nullptr;   // thay cho IMG_Load
+    void* target = nullptr;          // TextureHandle* / Mix_Chunk** / Mix_Music** / TTF_Font**
+    bool (*onReady)() = nullptr;     // gọi trên luồng chính khi đã gán xong; false = lỗi
+
+    // Worker ghi, luồng chính đọc sau khi thấy state == ASSET_DECODED
+    SDL_Surface* surface = nullptr;
+    void* result = nullptr;
+    std::atomic<int> state{0};
+};
+
+enum { ASSET_PENDING = 0, ASSET_DECODED, ASSET_DONE, ASSET_FAILED };
+
+struct AssetLoader {
+    AssetJob jobs[ASSET_LOADER_MAX_JOBS];
+    int jobCount = 0;
+    int finished = 0;                // số việc đã DONE hoặc FAILED (luồng chính)
+    int failed = 0;
+    const AssetPack* pack = nullptr;
+    TextureManager* textures = nullptr;
+    std::unique_ptr<JobPool> pool;
+    Uint64 startCounter = 0;
+};
+
+AssetJob* addAssetJob(AssetLoader& loader, const char* name, AssetKind kind, void* target,
+                      bool menuRequired);
+void startAssetLoader(AssetLoader& loader, const AssetPack* pack, TextureManager& textures);
+
+// Upload/gán các kết quả đã giải mã. Trả về true khi mọi việc đã kết thúc.
+bool pumpAssetLoader(AssetLoader& loader);
+bool menuAssetsReady(const AssetLoader& loader);
+float assetLoaderProgress(const AssetLoader& loader);
+
+// Chờ worker dừng và huỷ pool; kết quả chưa lấy về sẽ được giải phóng.
+void finishAssetLoader(AssetLoader& loader);
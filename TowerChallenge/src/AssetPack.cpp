@@ -0,0 +1,138 @@
+#include "AssetPack.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+static bool mapFile(AssetPack& pack, const char* path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    pack.fileHandle = file;
+    pack.mappingHandle = mapping;
+    pack.data = (const uint8_t*)view;
+    pack.size = size_t(size.QuadPart);
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);   // vùng map vẫn còn hiệu lực sau khi đóng fd
+    if (view == MAP_FAILED) return false;
+    pack.data = (const uint8_t*)view;
+    pack.size = size_t(st.st_size);
+#endif
+    return true;
+}
+
+bool openAssetPack(AssetPack& pack, const char* path) {
+    closeAssetPack(pack);
+    if (!mapFile(pack, path)) return false;
+
+    const PackHeader* header = (const PackHeader*)pack.data;
+    bool valid = pack.size >= sizeof(PackHeader) &&
+                 memcmp(header->magic, ASSET_PACK_MAGIC, 4) == 0 &&
+                 header->version == ASSET_PACK_VERSION &&
+                 header->entryCount <= (pack.size - sizeof(PackHeader)) / sizeof(PackEntry);
+    if (valid) {
+        pack.entries = (const PackEntry*)(pack.data + sizeof(PackHeader));
+        pack.entryCount = header->entryCount;
+        for (uint32_t i = 0; i < pack.entryCount && valid; i++) {
+            const PackEntry& e = pack.entries[i];
+            valid = e.offset <= pack.size && e.size <= pack.size - e.offset &&
+                    memchr(e.name, 0, sizeof(e.name)) != nullptr;
+            if (valid && e.type == PACK_IMAGE) {
+                valid = e.pitch >= e.width * 4 && uint64_t(e.pitch) * e.height <= e.size;
+            }
+        }
+    }
+    if (!valid) {
+        SDL_Log("Asset pack %s is corrupt or from another version", path);
+        closeAssetPack(pack);
+        return false;
+    }
+    return true;
+}
+
+void closeAssetPack(AssetPack& pack) {
+#ifdef _WIN32
+    if (pack.data) UnmapViewOfFile(pack.data);
+    if (pack.mappingHandle) CloseHandle((HANDLE)pack.mappingHandle);
+    if (pack.fileHandle) CloseHandle((HANDLE)pack.fileHandle);
+#else
+    if (pack.data) munmap((void*)pack.data, pack.size);
+#endif
+    pack = AssetPack();
+}
+
+const PackEntry* findPackEntry(const AssetPack& pack, const char* name) {
+    for (uint32_t i = 0; i < pack.entryCount; i++) {
+        if (strcmp(pack.entries[i].name, name) == 0) return &pack.entries[i];
+    }
+    return nullptr;
+}
+
+
+SDL_Texture* packTexture(SDL_Renderer* renderer, const AssetPack& pack, const char* name) {
+    const PackEntry* e = findPackEntry(pack, name);
+    if (!e || e->type != PACK_IMAGE) return nullptr;
+
+    SDL_Texture* tex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                         int(e->width), int(e->height));
+    if (!tex) {
+        SDL_Log("Pack texture %s: %s", name, SDL_GetError());
+        return nullptr;
+    }
+    if (SDL_UpdateTexture(tex, nullptr, pack.data + e->offset, int(e->pitch)) != 0) {
+        SDL_Log("Pack texture %s: %s", name, SDL_GetError());
+        SDL_DestroyTexture(tex);
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    return tex;
+}
+
+Mix_Chunk* packChunk(const AssetPack& pack, const char* name) {
+    const PackEntry* e = findPackEntry(pack, name);
+    if (!e || e->type != PACK_PCM) return nullptr;
+
+    int freq, channels;
+    Uint16 format;
+    if (!Mix_QuerySpec(&freq, &format, &channels)) return nullptr;
+    if (uint32_t(freq) != e->freq || format != e->format || channels != e->channels) {
+        SDL_Log("Pack PCM %s does not match the audio device, decoding the source", name);
+        return nullptr;
+    }
+    // Mixer chỉ đọc abuf; chunk từ QuickLoad không sở hữu bộ đệm
+    return Mix_QuickLoad_RAW((Uint8*)(pack.data + e->offset), Uint32(e->size));
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+
+#include <cstdint>
+
+// Gói tài nguyên nhị phân (assets/assets.pack) do tools/pack_assets tạo ra:
+// ảnh đã giải mã sẵn thành RGBA và thu nhỏ đúng kích thước vẽ, hiệu ứng âm
+// thanh đã giải mã thành PCM theo định dạng của mixer. Mỗi khối dữ liệu căn
+// theo ASSET_PACK_ALIGN nên runtime map cả file vào bộ nhớ và upload thẳng
+// từ vùng map, không qua bước giải mã nào. File ghi theo little-endian.
+
+const char ASSET_PACK_MAGIC[4] = {'T', 'C', 'P', 'K'};
+const uint32_t ASSET_PACK_VERSION = 1;
+const uint32_t ASSET_PACK_ALIGN = 64;
+const int ASSET_PACK_NAME_LEN = 48;
+const char* const ASSET_PACK_PATH = "assets/assets.pack";
+
+enum PackEntryType : uint32_t { PACK_IMAGE = 1, PACK_PCM = 2 };
+
+struct PackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+};
+
+struct PackEntry {
+    char name[ASSET_PACK_NAME_LEN];   // đường dẫn trong assets/, ví dụ "images/background.png"
+    uint32_t type;
+    uint32_t width;       // ảnh: kích thước và pitch, pixel SDL_PIXELFORMAT_RGBA32
+    uint32_t height;
+    uint32_t pitch;
+    uint32_t freq;        // PCM: tham số giống Mix_QuerySpec
+    uint16_t format;
+    uint16_t channels;
+    uint64_t offset;      // tính từ đầu file
+    uint64_t size;
+};
+static_assert(sizeof(PackHeader) == 16, "PackHeader layout");
+static_assert(sizeof(PackEntry) == 88, "PackEntry layout");
+
+struct AssetPack {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    const PackEntry* entries = nullptr;
+    uint32_t entryCount = 0;
+    void* fileHandle = nullptr;      // Windows: HANDLE của file và của mapping
+    void* mappingHandle = nullptr;
+};
+
+bool openAssetPack(AssetPack& pack, const char* path);
+void closeAssetPack(AssetPack& pack);
+const PackEntry* findPackEntry(const AssetPack& pack, const char* name);
+
+// Trả về nullptr nếu không có trong gói (khi đó nạp file lẻ như cũ).
+SDL_Texture* packTexture(SDL_Renderer* renderer, const AssetPack& pack, const char* name);
+// Chunk trỏ thẳng vào vùng map: phải Mix_FreeChunk trước closeAssetPack.
+// Trả về nullptr nếu PCM trong gói khác định dạng thiết bị đang mở.
+Mix_Chunk* packChunk(const AssetPack& pack, const char* name);
@@ -0,0 +1,32 @@
+#include "Camera.h"
+
+#include <cmath>
+
+using namespace std;
+
+
+void resetCamera(Camera& cam, int64_t y) {
+    cam.origin = y;
+    cam.offset = cam.prevOffset = 0.0;
+    cam.target = y;
+}
+
+void stepCamera(Camera& cam, double dt) {
+    cam.prevOffset = cam.offset;
+    double target = double(cam.target - cam.origin);
+    cam.offset += (target - cam.offset) * (1.0 - exp(-CAMERA_SMOOTH_RATE * dt));
+    if (fabs(target - cam.offset) < CAMERA_SNAP_PX) cam.offset = target;
+
+    // Dời gốc theo camera, dịch cả prevOffset để nội suy không bị giật
+    if (fabs(cam.offset) > CAMERA_REBASE_PX) {
+        int64_t shift = llround(cam.offset);
+        cam.origin += shift;
+        cam.offset -= double(shift);
+        cam.prevOffset -= double(shift);
+    }
+}
+
+int64_t cameraWorldY(const Camera& cam, double alpha) {
+    double y = cam.prevOffset + (cam.offset - cam.prevOffset) * alpha;
+    return cam.origin + llround(y);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+// Camera dọc theo tháp. Toạ độ thế giới là int64 (mỗi tile lên thêm 40px nên
+// int và float đều cạn độ chính xác khi tháp đủ cao); vị trí camera được
+// giữ dưới dạng độ lệch nhỏ (double) so với một gốc int64, gốc này dời theo
+// camera mỗi khi độ lệch vượt CAMERA_REBASE_PX. Phần vẽ chỉ nhận toạ độ
+// camera nguyên và trừ trong int64, nên mọi phép tính khi vẽ đều trên giá
+// trị nhỏ tương đối với màn hình.
+
+const double CAMERA_SMOOTH_RATE = 6.32;    // 1/s, = -60 ln(0.9): cũ là lerp 0.1 mỗi frame 60Hz
+const double CAMERA_SNAP_PX = 0.5;
+const double CAMERA_REBASE_PX = 4096.0;
+
+struct Camera {
+    int64_t origin = 0;       // gốc toạ độ, toạ độ thế giới
+    double offset = 0.0;      // vị trí camera so với origin
+    double prevOffset = 0.0;  // ở tick trước, để nội suy khi vẽ
+    int64_t target = 0;       // vị trí muốn tới, toạ độ thế giới
+};
+
+void resetCamera(Camera& cam, int64_t y);
+
+// Tiến dt giây: tiến về target theo hàm mũ (không phụ thuộc tần số tick).
+void stepCamera(Camera& cam, double dt);
+
+// Vị trí camera nội suy giữa tick trước và tick hiện tại, làm tròn về pixel.
+int64_t cameraWorldY(const Camera& cam, double alpha);
@@ -0,0 +1,51 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdint>
+
+using namespace std;
+
+
+bool initFrameArena(FrameArena& arena, size_t capacity) {
+    destroyFrameArena(arena);
+    arena.base = new char[capacity];
+    arena.capacity = capacity;
+    return true;
+}
+
+void destroyFrameArena(FrameArena& arena) {
+    delete[] arena.base;
+    arena = FrameArena();
+}
+
+void resetFrameArena(FrameArena& arena) {
+    arena.highWater = max(arena.highWater, arena.used);
+    arena.used = 0;
+}
+
+
+void* arenaAlloc(FrameArena& arena, size_t size, size_t align) {
+    uintptr_t start = uintptr_t(arena.base) + arena.used;
+    uintptr_t aligned = (start + align - 1) & ~uintptr_t(align - 1);
+    size_t offset = size_t(aligned - uintptr_t(arena.base));
+    if (!arena.base || offset + size > arena.capacity) return nullptr;
+    arena.used = offset + size;
+    return arena.base + offset;
+}
+
+const char* arenaPrintf(FrameArena& arena, const char* fmt, ...) {
+    if (!arena.base || arena.used >= arena.capacity) return "";
+    char* out = arena.base + arena.used;
+    size_t room = arena.capacity - arena.used;
+
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(out, room, fmt, args);
+    va_end(args);
+    if (n < 0 || size_t(n) >= room) return "";
+
+    arena.used += size_t(n) + 1;
+    return out;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+
+// Bộ cấp phát tuyến tính cho dữ liệu sống trong một frame (chuỗi hiển thị,
+// bộ đệm tạm). Cấp phát một lần lúc khởi động, mỗi frame chỉ đặt lại con trỏ.
+
+struct FrameArena {
+    char* base = nullptr;
+    size_t capacity = 0;
+    size_t used = 0;
+    size_t highWater = 0;
+};
+
+bool initFrameArena(FrameArena& arena, size_t capacity);
+void destroyFrameArena(FrameArena& arena);
+void resetFrameArena(FrameArena& arena);
+
+// Trả về nullptr nếu arena đã đầy.
+void* arenaAlloc(FrameArena& arena, size_t size, size_t align = alignof(std::max_align_t));
+
+// Định dạng chuỗi vào arena; trả về "" nếu không đủ chỗ.
+const char* arenaPrintf(FrameArena& arena, const char* fmt, ...);
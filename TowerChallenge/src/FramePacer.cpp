@@ -0,0 +1,110 @@
+#include "FramePacer.h"
+
+#include <cstring>
+
+const double PACER_DEFAULT_HZ = 60.0;
+const double PACER_SPIN_MS = 2.0;       // phần cuối chờ bằng quay vòng, không ngủ
+const double PACER_MISS_FACTOR = 1.5;   // frame dài hơn 1.5 chu kỳ = lỡ vblank
+const Uint32 PACER_PUMP_MS = 2;         // ngủ từng đoạn rồi bơm sự kiện (InputClock đóng dấu lúc đó)
+
+
+bool parsePacingMode(const char* name, PacingMode& mode) {
+    if (strcmp(name, "vsync") == 0) mode = PacingMode::VSYNC;
+    else if (strcmp(name, "uncapped") == 0) mode = PacingMode::UNCAPPED;
+    else if (strcmp(name, "limit") == 0) mode = PacingMode::LIMITER;
+    else return false;
+    return true;
+}
+
+const char* pacingModeName(PacingMode mode) {
+    switch (mode) {
+        case PacingMode::VSYNC: return "vsync";
+        case PacingMode::UNCAPPED: return "uncapped";
+        case PacingMode::LIMITER: return "limit";
+    }
+    return "?";
+}
+
+Uint32 pacingRendererFlags(PacingMode mode) {
+    return mode == PacingMode::VSYNC ? SDL_RENDERER_PRESENTVSYNC : 0;
+}
+
+
+void refreshPacingTarget(FramePacer& pacer, SDL_Window* window) {
+    double hz = pacer.overrideHz;
+    if (hz <= 0) {
+        SDL_DisplayMode dm;
+        int display = window ? SDL_GetWindowDisplayIndex(window) : 0;
+        if (display >= 0 && SDL_GetCurrentDisplayMode(display, &dm) == 0 && dm.refresh_rate > 0) {
+            hz = dm.refresh_rate;
+        } else {
+            hz = PACER_DEFAULT_HZ;
+        }
+    }
+    pacer.targetHz = hz;
+    pacer.period = Uint64(pacer.freq / hz);
+    pacer.deadline = SDL_GetPerformanceCounter() + pacer.period;
+}
+
+void initFramePacer(FramePacer& pacer, SDL_Window* window, PacingMode mode, double overrideHz) {
+    pacer = FramePacer();
+    pacer.mode = mode;
+    pacer.overrideHz = overrideHz;
+    pacer.freq = SDL_GetPerformanceFrequency();
+    refreshPacingTarget(pacer, window);
+    pacer.startCounter = pacer.lastFrameEnd = SDL_GetPerformanceCounter();
+    SDL_Log("Frame pacing: %s, target %.2f Hz", pacingModeName(mode), pacer.targetHz);
+}
+
+void setPacingMode(FramePacer& pacer, SDL_Renderer* renderer, PacingMode mode) {
+    pacer.mode = mode;
+    SDL_RenderSetVSync(renderer, mode == PacingMode::VSYNC ? 1 : 0);
+    pacer.deadline = SDL_GetPerformanceCounter() + pacer.period;
+    SDL_Log("Frame pacing: %s", pacingModeName(mode));
+}
+
+
+void waitNextFrame(FramePacer& pacer) {
+    if (pacer.mode == PacingMode::LIMITER) {
+        Uint64 spinTicks = Uint64(pacer.freq * PACER_SPIN_MS / 1000.0);
+        Uint64 now = SDL_GetPerformanceCounter();
+
+        // Ngủ phần lớn thời gian còn lại, chừa vài ms cuối để quay vòng
+        while (now + spinTicks < pacer.deadline) {
+            Uint32 sleepMs = Uint32((pacer.deadline - now - spinTicks) * 1000 / pacer.freq);
+            if (sleepMs == 0) break;
+            SDL_Delay(SDL_min(sleepMs, PACER_PUMP_MS));
+            SDL_PumpEvents();
+            now = SDL_GetPerformanceCounter();
+        }
+        while (now < pacer.deadline) now = SDL_GetPerformanceCounter();
+
+        // Trễ quá một chu kỳ thì đặt lại mốc, không cố đuổi kịp
+        pacer.deadline += pacer.period;
+        if (now > pacer.deadline) pacer.deadline = now + pacer.period;
+    }
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (pacer.mode != PacingMode::UNCAPPED && pacer.period > 0) {
+        Uint64 interval = now - pacer.lastFrameEnd;
+        if (interval > Uint64(pacer.period * PACER_MISS_FACTOR)) {
+            pacer.missedFrames += (interval + pacer.period / 2) / pacer.period - 1;
+        }
+    }
+    pacer.lastFrameEnd = now;
+    pacer.frames++;
+}
+
+void resumeFramePacing(FramePacer& pacer) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    pacer.lastFrameEnd = now;
+    pacer.deadline = now + pacer.period;
+}
+
+void logFramePacerStats(const FramePacer& pacer) {
+    double seconds = double(SDL_GetPerformanceCounter() - pacer.startCounter) / pacer.freq;
+    SDL_Log("Frame pacing (%s, %.2f Hz): %llu frames, %.1f fps avg, %llu missed",
+            pacingModeName(pacer.mode), pacer.targetHz,
+            (unsigned long long)pacer.frames, seconds > 0 ? pacer.frames / seconds : 0.0,
+            (unsigned long long)pacer.missedFrames);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+// Điều nhịp frame: chỉ chờ vsync, chạy không giới hạn (benchmark), hoặc
+// giới hạn bằng phần mềm (ngủ + quay vòng chính xác tới hạn chót).
+// Tần số mục tiêu lấy từ tần số quét của màn hình chứa cửa sổ.
+
+enum class PacingMode { VSYNC, UNCAPPED, LIMITER };
+
+struct FramePacer {
+    PacingMode mode = PacingMode::VSYNC;
+    double targetHz = 60.0;
+    double overrideHz = 0.0;    // > 0: bỏ qua tần số màn hình
+    Uint64 freq = 0;
+    Uint64 period = 0;          // chu kỳ mục tiêu, đơn vị performance counter
+    Uint64 deadline = 0;
+    Uint64 lastFrameEnd = 0;
+    Uint64 frames = 0;
+    Uint64 missedFrames = 0;
+    Uint64 startCounter = 0;
+};
+
+bool parsePacingMode(const char* name, PacingMode& mode);
+const char* pacingModeName(PacingMode mode);
+Uint32 pacingRendererFlags(PacingMode mode);
+
+void initFramePacer(FramePacer& pacer, SDL_Window* window, PacingMode mode, double overrideHz);
+void setPacingMode(FramePacer& pacer, SDL_Renderer* renderer, PacingMode mode);
+void refreshPacingTarget(FramePacer& pacer, SDL_Window* window);
+
+// Gọi ngay sau SDL_RenderPresent: chờ tới frame kế tiếp và đếm frame bị lỡ.
+// Chế độ LIMITER bơm sự kiện trong lúc ngủ để input được đóng dấu sát lúc tới.
+void waitNextFrame(FramePacer& pacer);
+// Gọi sau khi ngủ chờ sự kiện hoặc sau vòng lặp không vẽ: đặt lại mốc để
+// khoảng nghỉ không bị tính là frame lỡ.
+void resumeFramePacing(FramePacer& pacer);
+void logFramePacerStats(const FramePacer& pacer);
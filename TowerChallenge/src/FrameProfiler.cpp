@@ -0,0 +1,128 @@
+#include "FrameProfiler.h"
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace std;
+
+static const char* PHASE_NAMES[PHASE_COUNT + 1] = {
+    "events", "update", "camera", "background", "text+ui",
+    "tiles", "overlay", "present", "wait", "frame"
+};
+
+
+void initFrameProfiler(FrameProfiler& prof) {
+    destroyFrameProfiler(prof);
+    prof.msPerTick = 1000.0 / double(SDL_GetPerformanceFrequency());
+    prof.csv = new float[size_t(PROFILER_CSV_FRAMES) * PHASE_COUNT];
+}
+
+void destroyFrameProfiler(FrameProfiler& prof) {
+    delete[] prof.csv;
+    prof.csv = nullptr;
+}
+
+
+void addPhaseTime(FrameProfiler& prof, ProfilePhase phase, Uint64 start, Uint64 end) {
+    prof.current[phase] += float((end - start) * prof.msPerTick);
+}
+
+void endProfiledFrame(FrameProfiler& prof) {
+    copy(prof.current, prof.current + PHASE_COUNT, prof.window[prof.windowHead]);
+    prof.windowHead = (prof.windowHead + 1) % PROFILER_WINDOW;
+    prof.windowFilled = min(prof.windowFilled + 1, PROFILER_WINDOW);
+
+    if (prof.csv) {
+        float* row = prof.csv + size_t(prof.frames % PROFILER_CSV_FRAMES) * PHASE_COUNT;
+        copy(prof.current, prof.current + PHASE_COUNT, row);
+    }
+    prof.frames++;
+    fill(prof.current, prof.current + PHASE_COUNT, 0.0f);
+}
+
+void discardProfiledFrame(FrameProfiler& prof) {
+    fill(prof.current, prof.current + PHASE_COUNT, 0.0f);
+}
+
+
+static float sampleOf(const float* row, int phase) {
+    if (phase < PHASE_COUNT) return row[phase];
+    float total = 0;
+    for (int i = 0; i < PHASE_COUNT; i++) total += row[i];
+    return total;
+}
+
+PhaseStats phaseStats(const FrameProfiler& prof, int phase) {
+    PhaseStats st = {0, 0, 0, 0};
+    int n = prof.windowFilled;
+    if (n == 0) return st;
+
+    float samples[PROFILER_WINDOW];
+    float sum = 0;
+    for (int i = 0; i < n; i++) {
+        samples[i] = sampleOf(prof.window[i], phase);
+        sum += samples[i];
+    }
+    int p99 = min(n - 1, (n * 99) / 100);
+    nth_element(samples, samples + p99, samples + n);
+    st.p99Ms = samples[p99];
+    st.minMs = *min_element(samples, samples + n);
+    st.maxMs = *max_element(samples, samples + n);
+    st.avgMs = sum / n;
+    return st;
+}
+
+const char* phaseName(int phase) {
+    return PHASE_NAMES[phase];
+}
+
+
+void drawProfilerOverlay(SDL_Renderer* renderer, const TextAtlas& atlas, const FrameProfiler& prof) {
+    const int lineH = atlas.lineHeight;
+    SDL_Rect bg = {5, 55, 300, (PHASE_COUNT + 2) * lineH + 10};
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 170);
+    SDL_RenderFillRect(renderer, &bg);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Color yellow = {255, 215, 0, 255};
+    char line[96];
+    int y = bg.y + 5;
+    drawText(renderer, atlas, "ms     min   avg   p99", bg.x + 5, y, yellow);
+    y += lineH;
+    for (int phase = 0; phase <= PHASE_COUNT; phase++) {
+        PhaseStats st = phaseStats(prof, phase);
+        snprintf(line, sizeof(line), "%-10s %5.2f %5.2f %5.2f",
+                 phaseName(phase), st.minMs, st.avgMs, st.p99Ms);
+        drawText(renderer, atlas, line, bg.x + 5, y, phase == PHASE_COUNT ? yellow : white);
+        y += lineH;
+    }
+}
+
+bool writeProfilerCsv(const FrameProfiler& prof, const char* path) {
+    if (!prof.csv || prof.frames == 0) return false;
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+
+    fprintf(f, "frame");
+    for (int phase = 0; phase <= PHASE_COUNT; phase++) fprintf(f, ",%s_ms", phaseName(phase));
+    fprintf(f, "\n");
+
+    Uint64 first = prof.frames > PROFILER_CSV_FRAMES ? prof.frames - PROFILER_CSV_FRAMES : 0;
+    for (Uint64 frame = first; frame < prof.frames; frame++) {
+        const float* row = prof.csv + size_t(frame % PROFILER_CSV_FRAMES) * PHASE_COUNT;
+        fprintf(f, "%llu", (unsigned long long)frame);
+        for (int phase = 0; phase <= PHASE_COUNT; phase++) fprintf(f, ",%.4f", sampleOf(row, phase));
+        fprintf(f, "\n");
+    }
+    return fclose(f) == 0;
+}
+
+void logProfilerSummary(const FrameProfiler& prof) {
+    for (int phase = 0; phase <= PHASE_COUNT; phase++) {
+        PhaseStats st = phaseStats(prof, phase);
+        SDL_Log("%-10s min %.3f  avg %.3f  p99 %.3f  max %.3f ms",
+                phaseName(phase), st.minMs, st.avgMs, st.p99Ms, st.maxMs);
+    }
+}
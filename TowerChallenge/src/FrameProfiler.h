@@ -0,0 +1,70 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include "TextAtlas.h"
+#include "Trace.h"
+
+// Đo thời gian từng pha của frame bằng performance counter. Giữ cửa sổ
+// PROFILER_WINDOW frame gần nhất để tính min/avg/p99, vẽ overlay (F3) và
+// ghi từng frame ra CSV khi thoát để so sánh giữa các bản build/máy.
+
+enum ProfilePhase {
+    PHASE_EVENTS,
+    PHASE_UPDATE,
+    PHASE_CAMERA,
+    PHASE_BACKGROUND,
+    PHASE_TEXT,         // chữ, nút và icon
+    PHASE_TILES,
+    PHASE_OVERLAY,
+    PHASE_PRESENT,
+    PHASE_WAIT,
+    PHASE_COUNT
+};
+
+const int PROFILER_WINDOW = 240;
+const int PROFILER_CSV_FRAMES = 36000;   // ~10 phút ở 60 fps
+
+struct PhaseStats {
+    float minMs, avgMs, p99Ms, maxMs;
+};
+
+struct FrameProfiler {
+    double msPerTick = 0.0;
+    float current[PHASE_COUNT] = {};
+    float window[PROFILER_WINDOW][PHASE_COUNT] = {};
+    int windowHead = 0;
+    int windowFilled = 0;
+    float* csv = nullptr;          // PROFILER_CSV_FRAMES * PHASE_COUNT, vòng tròn
+    Uint64 frames = 0;
+    bool overlay = false;
+};
+
+void initFrameProfiler(FrameProfiler& prof);
+void destroyFrameProfiler(FrameProfiler& prof);
+
+void addPhaseTime(FrameProfiler& prof, ProfilePhase phase, Uint64 start, Uint64 end);
+void endProfiledFrame(FrameProfiler& prof);
+// Bỏ số đo đang cộng dồn (vòng lặp không vẽ gì, không tính là frame).
+void discardProfiledFrame(FrameProfiler& prof);
+
+PhaseStats phaseStats(const FrameProfiler& prof, int phase);   // phase == PHASE_COUNT: cả frame
+const char* phaseName(int phase);
+
+void drawProfilerOverlay(SDL_Renderer* renderer, const TextAtlas& atlas, const FrameProfiler& prof);
+bool writeProfilerCsv(const FrameProfiler& prof, const char* path);
+void logProfilerSummary(const FrameProfiler& prof);
+
+// Cộng thời gian của một khối lệnh vào pha tương ứng khi ra khỏi scope,
+// đồng thời ghi zone cùng tên vào trace.
+struct ProfileScope {
+    FrameProfiler& prof;
+    ProfilePhase phase;
+    Uint64 start;
+    ProfileScope(FrameProfiler& p, ProfilePhase ph)
+        : prof(p), phase(ph), start(SDL_GetPerformanceCounter()) { traceBegin(phaseName(ph)); }
+    ~ProfileScope() {
+        addPhaseTime(prof, phase, start, SDL_GetPerformanceCounter());
+        traceEnd(phaseName(phase));
+    }
+};
@@ -3,36 +3,48 @@
 #include <SDL2/SDL_mixer.h>
 #include <SDL2/SDL_ttf.h>
 
+#include "AllocCounter.h"
+#include "AssetLoader.h"
+#include "AssetPack.h"
+#include "Camera.h"
+#include "FrameArena.h"
+#include "FramePacer.h"
+#include "FrameProfiler.h"
+#include "InputClock.h"
+#include "ScreenCache.h"
+#include "StartupTimeline.h"
+#include "TextAtlas.h"
+#include "TextureManager.h"
+#include "TileBatch.h"
+#include "TowerStrips.h"
+#include "Trace.h"
+#include "UiAtlas.h"
+#include "UsageStats.h"
+#include "core/AutoPlayer.h"
+#include "core/Random.h"
+#include "core/Replay.h"
+#include "core/TowerCore.h"
+
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <string>
+#include <thread>
 #include <vector>
 #include <ctime>
 
 using namespace std; 
 
 
-static const SDL_Color COLORS[5] = {
-    {100, 200, 100, 255}, // xanh lá
-    {200, 50, 50, 255}, // đỏ
-    {150, 50, 150, 255},// tím
-    {255, 215,  0, 255}, // vàng
-    {50, 150, 200, 255}  // xanh dương
-};
-
-
 const int WINDOW_WIDTH = 450;
 const int WINDOW_HEIGHT = 600;
 const char* WINDOW_TITLE = "Tower Challenge";
 
 
-const int MAX_SPEED = 200;          
-const int INITIAL_TILE_WIDTH = 200;
-const int TILE_HEIGHT = 40;
-const int INITIAL_SPEED = 200;
-const int SPEED_INCREMENT = 1.25;
 const int SCREEN_MARGIN_TOP = 400; // camera cách mép trên 400px
-const float CAMERA_LERP = 0.1f; // tốc độ camera di chuyển
+const double MAX_FRAME_TIME = 0.25; // giới hạn thời gian 1 frame khi bị treo
 
 
 const SDL_Rect START_BTN_RECT = {(WINDOW_WIDTH - 200) / 2, 453, 200, 50};
@@ -40,20 +52,24 @@ const int MUTE_BTN_SIZE = 40;
 const SDL_Rect MUTE_BTN_RECT = {WINDOW_WIDTH - MUTE_BTN_SIZE - 10, 10, MUTE_BTN_SIZE, MUTE_BTN_SIZE};
 
 
-const char* FONT_PATH = "assets/fonts/font.ttf";
-const char* MUSIC_PATH = "assets/audio/background.mp3";
+const char* FONT_ASSET = "fonts/font.ttf";          // tên trong assets/
+const char* MUSIC_ASSET = "audio/background.mp3";
+const int FONT_SIZE = 24;
+const char* REPLAY_DIR = "replays";
+const char* TOWER_LOG_DIR = "tower_logs";   // lịch sử tháp mặc định, mỗi lần chạy một file
+const size_t FRAME_ARENA_SIZE = 64 * 1024;
+const int ALLOC_GUARD_WARMUP_FRAMES = 120;   // bỏ qua các frame đầu khi bộ đệm còn đang giãn
+const Uint32 IDLE_WAIT_MS = 500;        // màn hình tĩnh: thức dậy định kỳ dù không có sự kiện
+const Uint32 LOADING_WAIT_MS = 16;      // còn tài nguyên đang nạp thì thức dậy thường hơn
 const int MUSIC_VOLUME = MIX_MAX_VOLUME / 2;
+const double BOT_ATTRACT_DELAY = 2.0;   // bot đứng ở menu/game over bao lâu rồi chơi tiếp
 
 
 enum class GameState { MENU, PLAYING, GAME_OVER };
 
-
-struct Tile {
-    SDL_Rect rect;
-    int speed;
-    bool movingRight;
-    SDL_Color color;
-};
+// Nhóm thống kê CPU/GPU (UsageStats)
+enum { USAGE_MENU, USAGE_PLAYING, USAGE_PAUSED, USAGE_GAME_OVER, USAGE_MINIMIZED, USAGE_COUNT };
+const char* const USAGE_NAMES[USAGE_COUNT] = {"menu", "playing", "paused", "game-over", "minimized"};
 
 
 SDL_Window* gWindow = nullptr;
@@ -62,205 +78,386 @@ TTF_Font* gFont = nullptr;
 Mix_Music* gMusic = nullptr;
 Mix_Chunk* gPlaceSfx = nullptr;
 Mix_Chunk* gPerfectSfx = nullptr;
-SDL_Texture* gBgTex = nullptr;
-SDL_Texture* gMenuBg = nullptr;
-SDL_Texture* gIconMute   = nullptr;
-SDL_Texture* gIconUnmute = nullptr;
-int perfectTimer = 0;
+TextureManager gTextures;
+size_t gTextureBudget = DEFAULT_TEXTURE_BUDGET;   // --tex-budget-mb
+TextureHandle gBgTex = NO_TEXTURE;
+TextureHandle gMenuBg = NO_TEXTURE;
+TextureHandle gUiAtlas = NO_TEXTURE;     // icon mute/unmute, nút start
+SDL_Rect gUiRects[UI_SPRITE_COUNT];
+AssetPack gAssetPack;
+AssetLoader gAssetLoader;
+bool gAssetsDone = false;                // cả tài nguyên chỉ dùng khi chơi đã về
+bool gUseAssetPack = true;               // --no-pack: luôn nạp file lẻ để so sánh
+TextAtlas gTextAtlas;
+TileBatch gTileBatch;
+TowerStrips gTowerStrips;
+ScreenCache gMenuScreen;                 // menu và game over ghép sẵn, vẽ bằng một lần copy
+ScreenCache gGameOverScreen;
+float perfectTimer = 0;
 const int PERFECT_SHOW_MS = 1500;
 GameState gState = GameState::MENU;
 bool gMute = false;
 int gTopScore = 0;
-float cameraY_f = 0.0f;
+Camera gCamera;
+int gSimHz = TOWER_TICK_HZ;
+PacingMode gPacingMode = PacingMode::VSYNC;
+double gPacingHz = 0.0;
+FramePacer gPacer;
+FrameProfiler gProfiler;
+const char* gProfileCsvPath = nullptr;   // --profile-csv
+const char* gTracePath = nullptr;        // --trace
+FrameArena gFrameArena;
+bool gFailOnAlloc = false;               // --fail-on-alloc
+int gExitCode = 0;
+bool gWindowShown = false;
+bool gNeedRedraw = true;                 // màn hình tĩnh chỉ vẽ lại khi có sự kiện
+bool gPaused = false;                    // PLAYING tạm dừng vì mất focus
+bool gMinimized = false;
+UsageStats gUsage;
+bool gTowerLog = true;                   // --no-tower-log: chỉ giữ lịch sử gần nhất trong bộ nhớ
+char gTowerLogPath[64];
+InputClock gInputClock;                  // mốc performance counter của từng lần bấm
+
+
+// Phản hồi của frontend cho các sự kiện trong luật chơi
+struct GameEvents : TowerEvents {
+    void onTilePlaced(const TowerCore& core, const Tile& tile, bool perfect) override;
+    void onGameOver(const TowerCore& core) override;
+};
+
+TowerCore gCore;
+Pcg32 gRng;
+Replay gReplay;            // ván đang chơi, lưu ra file khi game over
+Replay gPlayback;          // replay nạp từ --replay
+bool gPlaybackActive = false;
+size_t gPlaybackPos = 0;
+bool gBotEnabled = false;  // --bot: attract mode / load test
+AutoPlayerConfig gBotConfig;
+AutoPlayer gBot;
+AutoPlayerPlan gBotPlan;
+size_t gBotPlanTiles = 0;  // kế hoạch ứng với tháp có chừng này tile, 0 = chưa có
+double gBotIdleSince = 0;
 
 
 bool initSDL();
+bool initLibraries();
+bool createWindowAndRenderer();
+void showWindowOnce();
 void cleanupSDL();
 bool loadAssets();
 void unloadAssets();
+bool onFontReady();
+bool onMusicReady();
+bool runSplash();
+void drawSplash(float progress);
 void run();
-SDL_Texture* renderText(const string& text, SDL_Color color);
+void filterEvents();
+bool isStaticScreen();
+void renderFrame(int64_t cameraY, double alpha);
+void drawBackground();
 void drawMenu();
-void handlePlaceTile(vector<Tile>& stack, int& score, float& desiredCamY);
-
+void drawGameOver();
+uint64_t menuScreenKey();
+uint64_t gameOverScreenKey();
+void initScreenCaches();
+void rebuildDeviceTextures();
+void startGame(GameEvents& events);
+void beginPlaying(GameEvents& events);
+void returnToMenu();
+void botUpdate(double now, double& simTime, double simDt, GameEvents& events);
+void playbackDrops();
+void stepSimulation(double dt);
+double eventTime(InputClock& clock, const SDL_Event& e, double now, double freq);
+void placeTileAt(double dropTime, double now, double& simTime, double simDt);
+void placeTileFromEvent(double dropTime, double now, double& simTime, double simDt, Uint64& eventsStart);
+
+
+// Chạy trên luồng riêng, song song với tạo cửa sổ/renderer ở luồng chính
+bool initLibraries() {
+    traceSetThreadName("init");
+    int step = startupBegin("TTF_Init");
+    int ttfResult = TTF_Init();
+    startupEnd(step);
+    if (ttfResult == -1) {
+        SDL_Log("TTF_Init Error: %s", TTF_GetError());
+        return false;
+    }
 
-bool initSDL() {
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
-        SDL_Log("SDL_Init Error: %s", SDL_GetError());
+    step = startupBegin("Mix_OpenAudio");
+    int audioResult = Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048);
+    startupEnd(step);
+    if (audioResult < 0) {
+        SDL_Log("Mix_OpenAudio Error: %s", Mix_GetError());
         return false;
     }
+    Mix_Init(MIX_INIT_MP3);
+
+    step = startupBegin("IMG_Init");
+    // Nạp sẵn bộ giải mã trước khi loader chạy để worker không tự khởi tạo song song
+    int imgFlags = IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG);
+    startupEnd(step);
+    if (!(imgFlags & IMG_INIT_PNG)) {
+    SDL_Log("IMG_Init Error: %s", IMG_GetError());
+    return false;
+    }
+    return true;
+}
 
+// Cửa sổ tạo ẩn, chỉ hiện khi frame đầu tiên đã vẽ xong (showWindowOnce)
+bool createWindowAndRenderer() {
+    int step = startupBegin("SDL_CreateWindow");
     gWindow = SDL_CreateWindow(WINDOW_TITLE, SDL_WINDOWPOS_CENTERED,
                                SDL_WINDOWPOS_CENTERED, WINDOW_WIDTH,
-                               WINDOW_HEIGHT, SDL_WINDOW_SHOWN);
+                               WINDOW_HEIGHT, SDL_WINDOW_HIDDEN);
+    startupEnd(step);
 
     if (!gWindow) {
         SDL_Log("SDL_CreateWindow Error: %s", SDL_GetError());
         return false;
     }
 
+    step = startupBegin("SDL_CreateRenderer");
     gRenderer = SDL_CreateRenderer(
-        gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+        gWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE |
+                     pacingRendererFlags(gPacingMode));
+    startupEnd(step);
     if (!gRenderer) {
         SDL_Log("SDL_CreateRenderer Error: %s", SDL_GetError());
         return false;
     }
+    initFramePacer(gPacer, gWindow, gPacingMode, gPacingHz);
+    initTextureManager(gTextures, gRenderer, gTextureBudget);
+    return true;
+}
 
-    if (TTF_Init() == -1) {
-        SDL_Log("TTF_Init Error: %s", TTF_GetError());
-        return false;
-    }
-
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
-        SDL_Log("Mix_OpenAudio Error: %s", Mix_GetError());
+bool initSDL() {
+    TRACE_SCOPE("initSDL");
+    int step = startupBegin("SDL_Init");
+    int initResult = SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO);
+    startupEnd(step);
+    if (initResult != 0) {
+        SDL_Log("SDL_Init Error: %s", SDL_GetError());
         return false;
     }
 
-    if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
-    SDL_Log("IMG_Init Error: %s", IMG_GetError());
-    return false;
-    }
+    // Mở thiết bị âm thanh, TTF và IMG không phụ thuộc cửa sổ: cho chạy chồng lên nhau
+    bool librariesOk = false;
+    thread libraries([&librariesOk] { librariesOk = initLibraries(); });
+    bool videoOk = createWindowAndRenderer();
+    libraries.join();
+    startupMark("initSDL done");
+    return videoOk && librariesOk;
+}
 
-    return true;
+// Hiện cửa sổ ngay trước lần present đầu tiên, để không lộ ra khung trống
+void showWindowOnce() {
+    if (gWindowShown) return;
+    SDL_ShowWindow(gWindow);
+    gWindowShown = true;
+    startupMark("window shown");
 }
 
 void cleanupSDL() {
     unloadAssets();
+    destroyTextureManager(gTextures);
     if (gRenderer) SDL_DestroyRenderer(gRenderer);
     if (gWindow) SDL_DestroyWindow(gWindow);
     Mix_CloseAudio();
+    Mix_Quit();
     TTF_Quit();
     IMG_Quit();
     SDL_Quit();
 }
 
 
+// Chỉ xếp việc cho loader; font, ảnh menu và icon phải về trước khi menu
+// nhận input, nhạc nền, ảnh nền khi chơi và SFX được phép về sau.
 bool loadAssets() {
-    gFont = TTF_OpenFont(FONT_PATH, 24);
-    if (!gFont) {
-        SDL_Log("Failed to load font: %s", TTF_GetError());
-        return false;
-    }
-    gMusic = Mix_LoadMUS(MUSIC_PATH);
-    if (!gMusic) {
-        SDL_Log("Failed to load music: %s", Mix_GetError());
-        return false;
-    }
-
-
-    gIconMute   = IMG_LoadTexture(gRenderer, "assets/images/icon_mute.png");
-    gIconUnmute = IMG_LoadTexture(gRenderer, "assets/images/icon_unmute.png");
-    if (!gIconMute || !gIconUnmute) {
-        SDL_Log("Failed to load icon: %s", IMG_GetError());
-        return false;
+    TRACE_SCOPE("loadAssets");
+    if (gUseAssetPack) {
+        traceBegin("assetPack");
+        if (!openAssetPack(gAssetPack, ASSET_PACK_PATH)) {
+            SDL_Log("No usable %s, decoding loose asset files", ASSET_PACK_PATH);
+        }
+        traceEnd("assetPack");
     }
+    gTextures.pack = gAssetPack.data ? &gAssetPack : nullptr;
+    initTowerStrips(gTowerStrips, gTextures, WINDOW_WIDTH, TILE_HEIGHT);
+    initScreenCaches();
+    Mix_VolumeMusic(MUSIC_VOLUME);
 
+    AssetLoader& l = gAssetLoader;
+    AssetJob* font = addAssetJob(l, FONT_ASSET, AssetKind::FONT, &gFont, true);
+    font->fontSize = FONT_SIZE;
+    font->onReady = onFontReady;
+    // Ảnh được thu nhỏ một lần về đúng kích thước vẽ
+    AssetJob* menuBg = addAssetJob(l, "images/menu_bg.png", AssetKind::TEXTURE, &gMenuBg, true);
+    menuBg->width = WINDOW_WIDTH;
+    menuBg->height = WINDOW_HEIGHT;
+    int uiW, uiH;
+    layoutUiAtlas(gUiRects, &uiW, &uiH);
+    AssetJob* ui = addAssetJob(l, UI_ATLAS_NAME, AssetKind::TEXTURE, &gUiAtlas, true);
+    ui->decodeSurface = buildUiAtlasSurface;
+    ui->reloadable = false;
+    addAssetJob(l, MUSIC_ASSET, AssetKind::MUSIC, &gMusic, false)->onReady = onMusicReady;
+    AssetJob* bg = addAssetJob(l, "images/background.png", AssetKind::TEXTURE, &gBgTex, false);
+    bg->width = WINDOW_WIDTH;
+    bg->height = WINDOW_HEIGHT;
+    addAssetJob(l, "audio/block_place.mp3", AssetKind::CHUNK, &gPlaceSfx, false);
+    addAssetJob(l, "audio/block_perfect.mp3", AssetKind::CHUNK, &gPerfectSfx, false);
+    startAssetLoader(l, &gAssetPack, gTextures);
+    return true;
+}
 
-    gPlaceSfx = Mix_LoadWAV("assets/audio/block_place.mp3");
-    gPerfectSfx = Mix_LoadWAV("assets/audio/block_perfect.mp3");
-    if (!gPlaceSfx || !gPerfectSfx) {
-        SDL_Log("Failed to load SFX: %s / %s",
-                Mix_GetError(), Mix_GetError());
+bool onFontReady() {
+    TRACE_SCOPE("textAtlas");
+    if (!buildTextAtlas(gTextAtlas, gTextures, gFont)) {
+        SDL_Log("Failed to build text atlas");
         return false;
     }
+    return true;
+}
 
-
-    SDL_Surface* bgSurf = IMG_Load("assets/images/background.png");
-    if (!bgSurf) {
-        SDL_Log("Failed to load background.png: %s", IMG_GetError());
-        return false;
-    }
-    gBgTex = SDL_CreateTextureFromSurface(gRenderer, bgSurf);
-    SDL_FreeSurface(bgSurf);
-    if (!gBgTex) { 
-        SDL_Log("Failed to create texture from background.png: %s", SDL_GetError());
-        return false;
-    }
+bool onMusicReady() {
+    if (!gMute) Mix_PlayMusic(gMusic, -1);
+    return true;
+}
 
 
-    Mix_VolumeMusic(MUSIC_VOLUME);
+// Màn chờ tối giản: chỉ vẽ hình chữ nhật, không cần font hay texture
+void drawSplash(float progress) {
+    SDL_SetRenderDrawColor(gRenderer, 20, 20, 30, 255);
+    SDL_RenderClear(gRenderer);
 
-    srand((unsigned)time(0));
+    SDL_Rect bar = {WINDOW_WIDTH / 4, WINDOW_HEIGHT / 2 - 6, WINDOW_WIDTH / 2, 12};
+    SDL_Rect fill = {bar.x, bar.y, int(bar.w * progress), bar.h};
+    SDL_SetRenderDrawColor(gRenderer, 255, 215, 0, 255);
+    SDL_RenderFillRect(gRenderer, &fill);
+    SDL_SetRenderDrawColor(gRenderer, 255, 255, 255, 255);
+    SDL_RenderDrawRect(gRenderer, &bar);
+}
 
-    if (!gMute && gMusic) { 
-        Mix_PlayMusic(gMusic, -1);
-    }
+// Chạy tới khi tài nguyên của menu đã sẵn sàng; false nếu lỗi hoặc người
+// chơi đóng cửa sổ.
+bool runSplash() {
+    TRACE_SCOPE("splash");
+    SDL_Event e;
+    for (;;) {
+        while (SDL_PollEvent(&e)) {
+            if (e.type == SDL_QUIT) return false;
+        }
+        gAssetsDone = pumpAssetLoader(gAssetLoader);
+        if (gAssetLoader.failed) {
+            SDL_Log("Exiting: asset loading failed.");
+            gExitCode = -1;
+            return false;
+        }
+        if (menuAssetsReady(gAssetLoader)) break;
 
-    SDL_Surface* surf = IMG_Load("assets/images/menu_bg.png");
-    if (!surf) {
-        SDL_Log("IMG_Load Error (menu_bg.png): %s", IMG_GetError());
-        return false;
-    }
-    gMenuBg = SDL_CreateTextureFromSurface(gRenderer, surf);
-    SDL_FreeSurface(surf);
-    if (!gMenuBg) { 
-        SDL_Log("Failed to create texture from menu_bg.png: %s", SDL_GetError());
-        return false;
+        drawSplash(assetLoaderProgress(gAssetLoader));
+        showWindowOnce();
+        SDL_RenderPresent(gRenderer);
+        waitNextFrame(gPacer);
     }
-
+    startupMark("menu assets ready");
+    SDL_Log("Menu ready after %.1f ms (%s)",
+            (SDL_GetPerformanceCounter() - gAssetLoader.startCounter) * 1000.0 /
+                SDL_GetPerformanceFrequency(),
+            gAssetPack.data ? "asset pack" : "loose files");
     return true;
 }
 
 
 void unloadAssets() {
+    finishAssetLoader(gAssetLoader);
     if (gMusic) Mix_FreeMusic(gMusic);
+    destroyTextAtlas(gTextAtlas, gTextures);
+    destroyTowerStrips(gTowerStrips, gTextures);
+    destroyScreenCache(gMenuScreen, gTextures);
+    destroyScreenCache(gGameOverScreen, gTextures);
     if (gFont) TTF_CloseFont(gFont);
     if (gPerfectSfx) Mix_FreeChunk(gPerfectSfx);
     if (gPlaceSfx)   Mix_FreeChunk(gPlaceSfx);
-    if (gBgTex) {
-        SDL_DestroyTexture(gBgTex);
-        gBgTex = nullptr;
-    }
-    if (gMenuBg) {
-        SDL_DestroyTexture(gMenuBg);
-        gMenuBg = nullptr;
-    }
-    if (gIconMute)   SDL_DestroyTexture(gIconMute);
-    if (gIconUnmute) SDL_DestroyTexture(gIconUnmute);
+    textureRelease(gTextures, gBgTex);
+    textureRelease(gTextures, gMenuBg);
+    textureRelease(gTextures, gUiAtlas);
 
     
     gMusic = nullptr;
     gFont = nullptr;
     gPerfectSfx = nullptr;
     gPlaceSfx   = nullptr;
-    gIconMute = nullptr;
-    gIconUnmute = nullptr;
+    // Chunk từ gói trỏ vào vùng map nên chỉ đóng gói sau khi đã giải phóng chúng
+    closeAssetPack(gAssetPack);
+}
+
+
+void initScreenCaches() {
+    if (!initScreenCache(gMenuScreen, gTextures, "menuScreen", WINDOW_WIDTH, WINDOW_HEIGHT) ||
+        !initScreenCache(gGameOverScreen, gTextures, "gameOverScreen", WINDOW_WIDTH, WINDOW_HEIGHT)) {
+        SDL_Log("Render targets unavailable, drawing static screens every frame");
+    }
 }
 
+// SDL_RENDER_DEVICE_RESET: mọi texture đã mất nội dung. Ảnh trong assets/
+// được TextureManager nạp lại khi dùng; phần còn lại tạo lại ở đây từ dữ
+// liệu phía CPU (font, ảnh UI), render target ghép lại ở lần vẽ sau.
+void rebuildDeviceTextures() {
+    textureManagerDeviceReset(gTextures);
+    initTowerStrips(gTowerStrips, gTextures, WINDOW_WIDTH, TILE_HEIGHT);
+    initScreenCaches();
 
-SDL_Texture* renderText(const string& text, SDL_Color color) {
-    if (!gFont) return nullptr; 
-    SDL_Surface* surf = TTF_RenderText_Blended(gFont, text.c_str(), color);
-    if (!surf) {
-        SDL_Log("TTF_RenderText_Blended error: %s", TTF_GetError());
-        return nullptr;
+    if (gTextAtlas.handle != NO_TEXTURE && gFont && !buildTextAtlas(gTextAtlas, gTextures, gFont)) {
+        SDL_Log("Failed to rebuild text atlas after device reset");
     }
-    SDL_Texture* tex = SDL_CreateTextureFromSurface(gRenderer, surf);
-    SDL_FreeSurface(surf);
-    if (!tex) {
-        SDL_Log("SDL_CreateTextureFromSurface error: %s", SDL_GetError());
+    if (gUiAtlas != NO_TEXTURE) {
+        textureRelease(gTextures, gUiAtlas);
+        SDL_Texture* tex = gAssetPack.data ? packTexture(gRenderer, gAssetPack, UI_ATLAS_NAME) : nullptr;
+        if (!tex) {
+            SDL_Surface* surf = buildUiAtlasSurface("assets");
+            if (surf) {
+                tex = SDL_CreateTextureFromSurface(gRenderer, surf);
+                SDL_FreeSurface(surf);
+            }
+        }
+        if (tex) SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+        gUiAtlas = adoptTexture(gTextures, tex, UI_ATLAS_NAME, false);
+        if (gUiAtlas == NO_TEXTURE) SDL_Log("Failed to rebuild UI atlas after device reset");
     }
-    return tex;
 }
 
+// Key của màn hình ghép sẵn: mọi thứ hiển thị trên màn hình đó. Ảnh nền khi
+// chơi có thể về sau menu nên gAssetsDone cũng là một đầu vào.
+uint64_t menuScreenKey() {
+    return (uint64_t(uint32_t(gTopScore)) << 2) | (uint64_t(gMute) << 1) | uint64_t(gAssetsDone);
+}
+
+uint64_t gameOverScreenKey() {
+    uint32_t top = uint32_t(max(gTopScore, gCore.score));
+    return (uint64_t(top) << 33) | (uint64_t(uint32_t(gCore.score)) << 1) | uint64_t(gAssetsDone);
+}
+
+void drawBackground() {
+    SDL_Texture* bg = textureGet(gTextures, gBgTex);
+    if (bg) SDL_RenderCopy(gRenderer, bg, nullptr, nullptr);
+    else {
+        SDL_SetRenderDrawColor(gRenderer, 135, 206, 235, 255); 
+        SDL_RenderClear(gRenderer);
+    }
+}
 
 void drawMenu() {
-    if (gMenuBg) SDL_RenderCopy(gRenderer, gMenuBg, nullptr, nullptr);
+    drawBackground();
+    SDL_Texture* menuBg = textureGet(gTextures, gMenuBg);
+    if (menuBg) SDL_RenderCopy(gRenderer, menuBg, nullptr, nullptr);
 
     int logoBottomY = 400;
     int padding = 10;
 
     SDL_Color yellowTextColor = {255, 255, 0, 255}; 
-    string scoreStr = "Top Score: " + to_string(gTopScore);
-    SDL_Texture* scoreTex = renderText(scoreStr, yellowTextColor);
-
-    if (scoreTex) {
-        int sw, sh;
-        SDL_QueryTexture(scoreTex, nullptr, nullptr, &sw, &sh);
-        SDL_Rect scoreRect = {(WINDOW_WIDTH - sw) / 2, logoBottomY + padding, sw, sh};
-        SDL_RenderCopy(gRenderer, scoreTex, nullptr, &scoreRect);
-        SDL_DestroyTexture(scoreTex);
-    }
+    const char* scoreStr = arenaPrintf(gFrameArena, "Top Score: %d", gTopScore);
+    drawTextCentered(gRenderer, gTextAtlas, scoreStr, WINDOW_WIDTH,
+                     logoBottomY + padding, yellowTextColor);
 
     // Nút Start
     SDL_SetRenderDrawColor(gRenderer, 255,215,0,255); 
@@ -268,71 +465,272 @@ void drawMenu() {
     SDL_SetRenderDrawColor(gRenderer, 0,0,0,255);
     SDL_RenderDrawRect(gRenderer, &START_BTN_RECT);
 
-    SDL_Texture* startTex = renderText("Start", {139,37,0,255});
-     if (startTex) {
-        int sw, sh;
-        SDL_QueryTexture(startTex, nullptr, nullptr, &sw, &sh);
-        SDL_Rect sr = {
-            START_BTN_RECT.x + (START_BTN_RECT.w - sw)/2,
-            START_BTN_RECT.y + (START_BTN_RECT.h - sh)/2,
-            sw, sh
-        };
-        SDL_RenderCopy(gRenderer, startTex, nullptr, &sr);
-        SDL_DestroyTexture(startTex);
-    }
+    int sw, sh;
+    measureText(gTextAtlas, "Start", &sw, &sh);
+    drawText(gRenderer, gTextAtlas, "Start",
+             START_BTN_RECT.x + (START_BTN_RECT.w - sw)/2,
+             START_BTN_RECT.y + (START_BTN_RECT.h - sh)/2,
+             {139,37,0,255});
 
     SDL_Rect mr = MUTE_BTN_RECT;
-    SDL_Texture* ico = gMute ? gIconMute : gIconUnmute;
-    if (ico) SDL_RenderCopy(gRenderer, ico, nullptr, &mr);
-
-    SDL_RenderPresent(gRenderer);
+    SDL_Texture* ui = textureGet(gTextures, gUiAtlas);
+    if (ui) SDL_RenderCopy(gRenderer, ui, &gUiRects[gMute ? UI_ICON_MUTE : UI_ICON_UNMUTE], &mr);
 }
 
+void drawGameOver() {
+    drawBackground();
+    SDL_Color black = {0, 0, 0, 255}; 
+    drawTextCentered(gRenderer, gTextAtlas, "Game Over", WINDOW_WIDTH, WINDOW_HEIGHT / 2 - 60, black);
 
-void handlePlaceTile(vector<Tile>& stack, int& score, float& desiredCamY) {
-    if (stack.size() < 2) return; 
+    const char* s = arenaPrintf(gFrameArena, "Score: %d", gCore.score);
+    drawTextCentered(gRenderer, gTextAtlas, s, WINDOW_WIDTH, WINDOW_HEIGHT / 2 - 20, black);
 
-    Tile& curr = stack.back();
-    Tile& prev = stack[stack.size() - 2];
-    int L = max(curr.rect.x, prev.rect.x);
-    int R = min(curr.rect.x + curr.rect.w, prev.rect.x + prev.rect.w);
-    int W = R - L;
+    const char* finalTopScore = arenaPrintf(gFrameArena, "Top Score: %d", max(gTopScore, gCore.score));
+    drawTextCentered(gRenderer, gTextAtlas, finalTopScore, WINDOW_WIDTH, WINDOW_HEIGHT / 2 + 20, black);
+}
 
-    if (W <= 0) {
-        gState = GameState::GAME_OVER;
 
+void GameEvents::onTilePlaced(const TowerCore& core, const Tile& tile, bool perfect) {
+    TRACE_SCOPE("Mix_PlayChannel");
+    if (perfect) {
+        perfectTimer = PERFECT_SHOW_MS;
+        if (gPerfectSfx) Mix_PlayChannel(-1, gPerfectSfx, 0);
     } else {
-        
-        bool isPerfect = (abs(curr.rect.x - prev.rect.x) < 2 && W >= prev.rect.w - 2);
-
-        if (isPerfect) {
-            perfectTimer = PERFECT_SHOW_MS;
-            if (gPerfectSfx) Mix_PlayChannel(-1, gPerfectSfx, 0);
-            score += 5;
-            curr.rect.x = prev.rect.x;
-            curr.rect.w = prev.rect.w;
-        } else {
-            if (gPlaceSfx) Mix_PlayChannel(-1, gPlaceSfx, 0);
-            score += 1;
-            curr.rect.x = L;
-            curr.rect.w = W;
-            curr.speed = min(MAX_SPEED, (int)(curr.speed + SPEED_INCREMENT));
+        if (gPlaceSfx) Mix_PlayChannel(-1, gPlaceSfx, 0);
+    }
+
+    if (core.tiles.size() >= 5) {
+        gCamera.target = tile.y - SCREEN_MARGIN_TOP;
+    }
+}
+
+void GameEvents::onGameOver(const TowerCore& core) {
+    gState = GameState::GAME_OVER;
+
+    if (gPlaybackActive) {
+        ReplayResult result;
+        result.score = core.score;
+        result.tileCount = uint32_t(core.tiles.size());
+        result.towerHash = towerHash(core);
+        SDL_Log("Replay %s: score %d (recorded %d)",
+                replayMatches(gPlayback, result) ? "matches" : "MISMATCH",
+                core.score, gPlayback.finalScore);
+        gPlaybackActive = false;
+        return;
+    }
+
+    finishReplay(gReplay, core);
+    // loadReplay/verify_replays chỉ nhận tần số tick chuẩn
+    if (gReplay.tickHz != TOWER_TICK_HZ) {
+        SDL_Log("Replay not saved: --sim-hz %d differs from %d", gReplay.tickHz, TOWER_TICK_HZ);
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(REPLAY_DIR, ec);
+    char path[64];
+    snprintf(path, sizeof(path), "%s/%016llx.tcr", REPLAY_DIR, (unsigned long long)gReplay.seed);
+    if (!saveReplay(path, gReplay)) {
+        SDL_Log("Failed to save replay %s", path);
+    }
+}
+
 
+void startGame(GameEvents& events) {
+    // Mỗi ván có hạt giống riêng; khi xem replay thì dùng hạt giống đã ghi
+    uint64_t seed = gPlaybackActive ? gPlayback.seed
+                                    : SDL_GetPerformanceCounter() ^ (uint64_t(time(0)) << 32);
+    gRng.seed(seed);
+    towerReset(gCore, &gRng, &events, gSimHz);
+    beginReplay(gReplay, seed, gSimHz);
+    gPlaybackPos = 0;
+
+    resetTileBatch(gTileBatch);
+    invalidateTowerStrips(gTowerStrips);
+    gPaused = false;
+    gBotPlanTiles = 0;
+    resetCamera(gCamera, 0);
+    playbackDrops();
+}
+
+void beginPlaying(GameEvents& events) {
+    startGame(events);
+    if (!gMute && gMusic) Mix_PlayMusic(gMusic, -1);
+    gState = GameState::PLAYING;
+}
+
+void returnToMenu() {
+    gTopScore = max(gTopScore, gCore.score);
+    gState = GameState::MENU;
+    resetCamera(gCamera, 0);
+    gNeedRedraw = true;
+}
+
+// Bot đi cùng đường với người chơi: lên kế hoạch một lần cho mỗi tile, tới
+// lúc thì gọi placeTileAt như một lần bấm (được ghi vào replay như thường).
+void botUpdate(double now, double& simTime, double simDt, GameEvents& events) {
+    if (gState != GameState::PLAYING) {
+        if (gBotIdleSince == 0) gBotIdleSince = now;
+        if (now - gBotIdleSince < BOT_ATTRACT_DELAY) return;
+        gBotIdleSince = 0;
+        if (gState == GameState::GAME_OVER) returnToMenu();
+        else beginPlaying(events);
+        return;
+    }
+    if (gPaused || gPlaybackActive) return;
+
+    if (gBotPlanTiles != gCore.tiles.size()) {
+        TRACE_SCOPE("botDecide");
+        if (!autoPlayerDecide(gBot, gCore, gBotPlan)) return;
+        autoPlayerJitter(gBot, gCore, gBotPlan);
+        gBotPlanTiles = gCore.tiles.size();
+    }
+    double ticksAhead = double(gBotPlan.tick - gCore.tick) + double(gBotPlan.fraction) / TOWER_FP_ONE;
+    double dropTime = simTime + ticksAhead * simDt;
+    if (dropTime > now) return;
+    traceInstant("input");
+    placeTileAt(dropTime, now, simTime, simDt);
+}
+
+// Xem replay: thả đúng tại tick đã ghi
+void playbackDrops() {
+    while (gPlaybackActive && gPlaybackPos < gPlayback.drops.size() &&
+           gPlayback.drops[gPlaybackPos].tick == gCore.tick) {
+        const ReplayDrop& d = gPlayback.drops[gPlaybackPos++];
+        towerPlaceTileFixed(gCore, d.fraction);
+    }
+}
+
+
+void stepSimulation(double dt) {
+    {
+        ProfileScope scope(gProfiler, PHASE_UPDATE);
+        towerTick(gCore);
+        playbackDrops();
+    }
+
+    ProfileScope scope(gProfiler, PHASE_CAMERA);
+    stepCamera(gCamera, dt);
+
+    if (perfectTimer > 0) {
+        perfectTimer -= float(dt * 1000);
+        if (perfectTimer < 0) perfectTimer = 0;
+    }
+}
+
+
+// Thời điểm sự kiện vào hàng đợi (InputClock), cùng thang với
+// SDL_GetPerformanceCounter() / freq; không có dấu thì coi như vừa xảy ra
+double eventTime(InputClock& clock, const SDL_Event& e, double now, double freq) {
+    Uint64 counter = inputEventCounter(clock, e, 0);
+    return counter ? counter / freq : now;
+}
+
+void placeTileAt(double dropTime, double now, double& simTime, double simDt) {
+    TRACE_SCOPE("placeTile");
+    // Sự kiện bơm sau mốc now của frame vẫn thuộc frame này, không chạy quá now
+    dropTime = min(dropTime, now);
+    // Chạy mô phỏng tới tick ngay trước lúc bấm, phần lẻ còn lại tính giải tích
+    double dt = dropTime - simTime;
+    while (dt >= simDt) {
+        stepSimulation(simDt);
+        simTime += simDt;
+        dt -= simDt;
+    }
+    if (gPlaybackActive) return;   // đang xem replay, bỏ qua input
+    replayRecordDrop(gReplay, gCore, max(0.0, dt / simDt));
+}
+
+// placeTileAt giữa vòng sự kiện chạy mô phỏng (đã tính vào PHASE_UPDATE,
+// PHASE_CAMERA): dừng đồng hồ PHASE_EVENTS quanh nó để không tính hai lần
+void placeTileFromEvent(double dropTime, double now, double& simTime, double simDt, Uint64& eventsStart) {
+    addPhaseTime(gProfiler, PHASE_EVENTS, eventsStart, SDL_GetPerformanceCounter());
+    placeTileAt(dropTime, now, simTime, simDt);
+    eventsStart = SDL_GetPerformanceCounter();
+}
+
+
+// Bỏ các loại sự kiện game không dùng để chúng không đánh thức vòng lặp
+void filterEvents() {
+    const Uint32 ignored[] = {
+        SDL_MOUSEMOTION, SDL_MOUSEBUTTONUP, SDL_MOUSEWHEEL, SDL_KEYUP,
+        SDL_TEXTINPUT, SDL_TEXTEDITING, SDL_KEYMAPCHANGED,
+        SDL_FINGERDOWN, SDL_FINGERUP, SDL_FINGERMOTION, SDL_MULTIGESTURE, SDL_DOLLARGESTURE,
+        SDL_JOYAXISMOTION, SDL_JOYBALLMOTION, SDL_JOYHATMOTION, SDL_JOYBUTTONDOWN, SDL_JOYBUTTONUP,
+        SDL_CONTROLLERAXISMOTION, SDL_CONTROLLERBUTTONDOWN, SDL_CONTROLLERBUTTONUP,
+        SDL_SENSORUPDATE, SDL_DROPFILE, SDL_DROPTEXT, SDL_DROPBEGIN, SDL_DROPCOMPLETE,
+        SDL_AUDIODEVICEADDED, SDL_AUDIODEVICEREMOVED, SDL_SYSWMEVENT,
+    };
+    for (Uint32 type : ignored) SDL_EventState(type, SDL_IGNORE);
+    SDL_StopTextInput();
+}
+
+// Không có gì chuyển động: menu, game over, đang tạm dừng hoặc thu nhỏ.
+// Overlay profiler cập nhật liên tục nên khi bật thì luôn vẽ.
+bool isStaticScreen() {
+    if (gMinimized) return true;
+    if (gProfiler.overlay) return false;
+    return gState != GameState::PLAYING || gPaused;
+}
+
+// Vẽ toàn bộ một frame (chưa present)
+void renderFrame(int64_t cameraY, double alpha) {
+    if (gState == GameState::MENU) {
+        ProfileScope scope(gProfiler, PHASE_BACKGROUND);
+        drawScreenCache(gRenderer, gMenuScreen, menuScreenKey(), drawMenu);
+    } else if (gState == GameState::GAME_OVER) {
+        ProfileScope scope(gProfiler, PHASE_BACKGROUND);
+        drawScreenCache(gRenderer, gGameOverScreen, gameOverScreenKey(), drawGameOver);
+    } else {
+        {
+            ProfileScope scope(gProfiler, PHASE_BACKGROUND);
+            drawBackground();
+        }
+        {
+            ProfileScope scope(gProfiler, PHASE_TEXT);
+            SDL_Color whiteColor = {255, 255, 255, 255};
+            drawText(gRenderer, gTextAtlas, arenaPrintf(gFrameArena, "%d", gCore.score), 10, 10, whiteColor);
+        }
+        {
+            ProfileScope scope(gProfiler, PHASE_TILES);
+            const TowerStore& stack = gCore.tiles;
+            size_t liveFirst = drawTowerStrips(gRenderer, gTowerStrips, stack, cameraY, WINDOW_HEIGHT);
+            drawTileBatch(gRenderer, gTileBatch, stack, liveFirst, stack.size(), cameraY, alpha);
         }
 
-        curr.rect.y = prev.rect.y - TILE_HEIGHT;
+        ProfileScope scope(gProfiler, PHASE_TEXT);
+        if (perfectTimer > 0) {
+            SDL_Color c = {255,215,0, 255}; 
+            drawTextCentered(gRenderer, gTextAtlas, "Perfect +5", WINDOW_WIDTH, WINDOW_HEIGHT / 3, c);
+        }
 
-        if (stack.size() >= 5) {
-            desiredCamY = (float)(curr.rect.y - SCREEN_MARGIN_TOP);
+        SDL_Rect mr = MUTE_BTN_RECT;
+        SDL_Texture* ui = textureGet(gTextures, gUiAtlas);
+        if (ui) SDL_RenderCopy(gRenderer, ui, &gUiRects[gMute ? UI_ICON_MUTE : UI_ICON_UNMUTE], &mr);
+
+        if (gPaused) {
+            SDL_SetRenderDrawBlendMode(gRenderer, SDL_BLENDMODE_BLEND);
+            SDL_SetRenderDrawColor(gRenderer, 0, 0, 0, 140);
+            SDL_RenderFillRect(gRenderer, nullptr);
+            SDL_Color white = {255, 255, 255, 255};
+            drawTextCentered(gRenderer, gTextAtlas, "Paused", WINDOW_WIDTH, WINDOW_HEIGHT / 2 - 30, white);
+            drawTextCentered(gRenderer, gTextAtlas, "Click to resume", WINDOW_WIDTH, WINDOW_HEIGHT / 2 + 10, white);
         }
+    }
 
-        // Thêm thanh di chuyển tiếp theo
-        stack.push_back(Tile{
-            {0, curr.rect.y - TILE_HEIGHT, curr.rect.w, TILE_HEIGHT},
-            curr.speed, 
-            (rand() % 2 == 0), 
-            COLORS[rand() % 5]
-        });
+    if (gProfiler.overlay) {
+        ProfileScope scope(gProfiler, PHASE_OVERLAY);
+        drawProfilerOverlay(gRenderer, gTextAtlas, gProfiler);
+        const char* texLine = arenaPrintf(gFrameArena, "tex %d  %.2f MB  +%d -%d",
+                                          gTextures.live, gTextures.bytes / 1048576.0,
+                                          gTextures.createdLastFrame, gTextures.destroyedLastFrame);
+        drawText(gRenderer, gTextAtlas, texLine, 10, WINDOW_HEIGHT - 30, {255, 255, 255, 255});
+        if (gBotEnabled) {
+            const AutoPlayerStats& bs = gBot.stats;
+            const char* botLine = arenaPrintf(gFrameArena, "bot depth %d  exp %.1f  %.0f dec/s",
+                                              gBotPlan.depth, gBotPlan.expected,
+                                              bs.searchSeconds > 0 ? bs.decisions / bs.searchSeconds : 0.0);
+            drawText(gRenderer, gTextAtlas, botLine, 10, WINDOW_HEIGHT - 60, {255, 255, 255, 255});
+        }
     }
 }
 
@@ -340,24 +738,110 @@ void handlePlaceTile(vector<Tile>& stack, int& score, float& desiredCamY) {
 void run() {
     bool quit = false;
     SDL_Event e;
-    vector<Tile> stack;
-    int score = 0;
-    Uint32 lastTime = SDL_GetTicks();
-    float desiredCamY = 0.0f;
+    GameEvents events;
+    const double freq = double(SDL_GetPerformanceFrequency());
+    const double simDt = 1.0 / gSimHz;
+    double simTime = SDL_GetPerformanceCounter() / freq;  // thời điểm của trạng thái mô phỏng
+    int steadyFrames = 0;           // số frame PLAYING liên tiếp, không đổi trạng thái
+    Uint64 allocFrames = 0, maxFrameAllocs = 0;
+    Uint64 textureChurnFrames = 0;  // frame ổn định vẫn tạo/huỷ texture
+    initUsageStats(gUsage, USAGE_NAMES, USAGE_COUNT);
+    initInputClock(gInputClock);
 
     while (!quit) {
-        Uint32 now = SDL_GetTicks();
-        float delta = (now - lastTime) / 1000.0f;
-        if (delta == 0) { 
-            delta = 1.0f / 60.0f; 
+        TRACE_SCOPE("frame");
+        Uint64 loopStart = SDL_GetPerformanceCounter();
+        int usageSlot = gMinimized ? USAGE_MINIMIZED
+                      : gState == GameState::MENU ? USAGE_MENU
+                      : gState == GameState::GAME_OVER ? USAGE_GAME_OVER
+                      : gPaused ? USAGE_PAUSED : USAGE_PLAYING;
+        resetFrameArena(gFrameArena);
+        beginTextureFrame(gTextures);
+        if (!gAssetsDone) {
+            gAssetsDone = pumpAssetLoader(gAssetLoader);
+            if (gAssetLoader.failed) {
+                SDL_Log("Exiting: asset loading failed.");
+                gExitCode = -1;
+                break;
+            }
+            // Menu đổi hình khi tài nguyên về đủ (menuScreenKey): vẽ lại dù không có sự kiện
+            if (gAssetsDone) gNeedRedraw = true;
         }
-        lastTime = now;
+        uint64_t allocsBefore = allocCount();
+        GameState frameState = gState;
+
+        // Màn hình tĩnh đã vẽ xong: ngủ tới khi có sự kiện thay vì vẽ lại
+        Uint64 idleTicks = 0;
+        if (!gNeedRedraw && isStaticScreen()) {
+            // Thời gian ngủ chỉ vào UsageStats, không vào profiler hay số frame lỡ
+            TRACE_SCOPE("idleWait");
+            Uint64 idleStart = SDL_GetPerformanceCounter();
+            SDL_WaitEventTimeout(nullptr, gAssetsDone ? IDLE_WAIT_MS : LOADING_WAIT_MS);
+            idleTicks = SDL_GetPerformanceCounter() - idleStart;
+            resumeFramePacing(gPacer);
+        }
+
+        // Bơm trước khi lấy mốc now: input tới giờ đều đã có dấu không muộn hơn now
+        Uint64 eventsStart = SDL_GetPerformanceCounter();
+        SDL_PumpEvents();
+        double now = SDL_GetPerformanceCounter() / freq;
+        if (now - simTime > MAX_FRAME_TIME) simTime = now - MAX_FRAME_TIME;
 
         while (SDL_PollEvent(&e)) {
             if (e.type == SDL_QUIT) {
                 quit = true;
                 break;
             }
+            // Lấy dấu cho mọi lần bấm, kể cả lần không thả tile, để hàng dấu không lệch
+            double inputTime = eventTime(gInputClock, e, now, freq);
+            // Sự kiện không cần thiết đã bị lọc (filterEvents), còn lại đều có thể đổi hình
+            gNeedRedraw = true;
+            if (e.type == SDL_WINDOWEVENT) {
+                switch (e.window.event) {
+                case SDL_WINDOWEVENT_FOCUS_LOST:
+                    if (gState == GameState::PLAYING && !gBotEnabled) gPaused = true;
+                    break;
+                case SDL_WINDOWEVENT_MINIMIZED:
+                case SDL_WINDOWEVENT_HIDDEN:
+                    gMinimized = true;
+                    if (gState == GameState::PLAYING) gPaused = true;
+                    break;
+                case SDL_WINDOWEVENT_RESTORED:
+                case SDL_WINDOWEVENT_MAXIMIZED:
+                case SDL_WINDOWEVENT_SHOWN:
+                    gMinimized = false;
+                    break;
+                }
+            }
+            if (e.type == SDL_RENDER_TARGETS_RESET) {
+                invalidateTowerStrips(gTowerStrips);
+                invalidateScreenCache(gMenuScreen);
+                invalidateScreenCache(gGameOverScreen);
+            }
+            if (e.type == SDL_RENDER_DEVICE_RESET) {
+                rebuildDeviceTextures();
+                gNeedRedraw = true;
+            }
+            if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_DISPLAY_CHANGED) {
+                refreshPacingTarget(gPacer, gWindow);
+            }
+            if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F2) {
+                // F2: đổi chế độ điều nhịp vsync -> uncapped -> limit
+                PacingMode next = gPacer.mode == PacingMode::VSYNC ? PacingMode::UNCAPPED
+                                : gPacer.mode == PacingMode::UNCAPPED ? PacingMode::LIMITER
+                                : PacingMode::VSYNC;
+                setPacingMode(gPacer, gRenderer, next);
+            }
+            if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F3) {
+                gProfiler.overlay = !gProfiler.overlay;
+            }
+            if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F9 && gTracePath) {
+                traceWrite(gTracePath);
+                SDL_Log("Trace written to %s", gTracePath);
+            }
+            if (e.type == SDL_MOUSEBUTTONDOWN || e.type == SDL_KEYDOWN) {
+                traceInstant("input");
+            }
             if (gState == GameState::MENU && e.type == SDL_MOUSEBUTTONDOWN) {
                 SDL_Point p{e.button.x, e.button.y};
 
@@ -369,25 +853,7 @@ void run() {
                         else if (gMusic) Mix_PlayMusic(gMusic, -1);
                     }
                 } else if (SDL_PointInRect(&p, &START_BTN_RECT)) {
-                    stack.clear();
-                    score = 0;
-                    cameraY_f = 0;
-                    desiredCamY = 0;
-                    int baseY = WINDOW_HEIGHT - TILE_HEIGHT;
-                    stack.push_back(Tile{
-                        {(WINDOW_WIDTH - INITIAL_TILE_WIDTH) / 2, baseY, INITIAL_TILE_WIDTH, TILE_HEIGHT},
-                        0, // Thanh mốc đứng im
-                        false,
-                        COLORS[rand() % 5]
-                    });
-                    stack.push_back(Tile{
-                        {0, baseY - TILE_HEIGHT, INITIAL_TILE_WIDTH, TILE_HEIGHT},
-                        INITIAL_SPEED,
-                        true,
-                        COLORS[rand() % 5]
-                    });
-                    if (!gMute && gMusic) Mix_PlayMusic(gMusic, -1);
-                    gState = GameState::PLAYING;
+                    beginPlaying(events);
                 }
 
             } else if (gState == GameState::PLAYING) {
@@ -400,151 +866,215 @@ void run() {
                              if (Mix_PausedMusic()) Mix_ResumeMusic();
                              else if (gMusic) Mix_PlayMusic(gMusic, -1);
                         }
+                    } else if (gPaused) {
+                        gPaused = false;   // lần bấm đầu tiên chỉ để chơi tiếp
+                        simTime = now;
                     } else {
-                        handlePlaceTile(stack, score, desiredCamY);
+                        placeTileFromEvent(inputTime, now, simTime, simDt, eventsStart);
                     }
                 } else if (e.type == SDL_KEYDOWN) {
-                    if (e.key.keysym.sym == SDLK_SPACE) {
+                    if (e.key.keysym.sym == SDLK_SPACE && gPaused) {
+                        gPaused = false;
+                        simTime = now;
+                    } else if (e.key.keysym.sym == SDLK_SPACE) {
                         // Nhấn phím Space -> đặt gạch
-                        handlePlaceTile(stack, score, desiredCamY);
+                        placeTileFromEvent(inputTime, now, simTime, simDt, eventsStart);
                     }
                 }
             } else if (gState == GameState::GAME_OVER && e.type == SDL_MOUSEBUTTONDOWN) {
-                gTopScore = max(gTopScore, score);
-                gState = GameState::MENU;
-                cameraY_f = 0.0f;
-                desiredCamY = 0.0f;
+                returnToMenu();
             }
         }
         if (quit) break;
+        addPhaseTime(gProfiler, PHASE_EVENTS, eventsStart, SDL_GetPerformanceCounter());
 
 
-        if (gState == GameState::PLAYING && stack.size() >= 2) { 
-            Tile& t = stack.back();
-            int dir = t.movingRight ? 1 : -1;
-            t.rect.x += int(dir * t.speed * delta);
-
-            if (t.rect.x + t.rect.w > WINDOW_WIDTH) {
-                t.movingRight = false;
-                t.rect.x = WINDOW_WIDTH - t.rect.w; 
-            }
-            if (t.rect.x < 0) {
-                t.movingRight = true;
-                t.rect.x = 0; 
-            }
-        }
+        if (gBotEnabled) botUpdate(now, simTime, simDt, events);
 
-
-        if (gState == GameState::PLAYING) {
-            cameraY_f += (desiredCamY - cameraY_f) * CAMERA_LERP;
-            if (abs(cameraY_f - desiredCamY) < 0.5f) { 
-                cameraY_f = desiredCamY;
-            }
+        // Mô phỏng chạy theo tick cố định, độc lập với tần số màn hình;
+        // khi tạm dừng thì không tích thời gian để lúc chơi tiếp không phải đuổi
+        if (gPaused) simTime = now;
+        while (simTime + simDt <= now) {
+            if (gState == GameState::PLAYING) stepSimulation(simDt);
+            simTime += simDt;
         }
-        int cameraY = int(round(cameraY_f));
-
-
-        if (gBgTex) SDL_RenderCopy(gRenderer, gBgTex, nullptr, nullptr);
-        else {
-            SDL_SetRenderDrawColor(gRenderer, 135, 206, 235, 255); 
-            SDL_RenderClear(gRenderer);
+        if (gCore.tiles.spillError) {
+            SDL_Log("Tower log %s: %s; keeping only the last %zu history blocks in memory",
+                    gCore.tiles.spillPath, gCore.tiles.spillError, TOWER_HISTORY_MAX_BLOCKS);
+            gCore.tiles.spillError = nullptr;
         }
 
+        // Nội suy giữa hai trạng thái mô phỏng gần nhất để vẽ
+        double alpha = (now - simTime) / simDt;
+        int64_t cameraY = cameraWorldY(gCamera, alpha);
 
-        if (gState == GameState::MENU) {
-            drawMenu();
-        } else if (gState == GameState::PLAYING) {
-            SDL_Color whiteColor = {255, 255, 255, 255};
-            SDL_Texture* currScoreTex = renderText(to_string(score), whiteColor);
-            if (currScoreTex) {
-                int sw, sh;
-                SDL_QueryTexture(currScoreTex, nullptr, nullptr, &sw, &sh);
-                SDL_Rect scoreRect = { 10, 10, sw, sh };
-                SDL_RenderCopy(gRenderer, currScoreTex, nullptr, &scoreRect);
-                SDL_DestroyTexture(currScoreTex);
-            }
-
-            for (const auto& tile : stack) { 
-                SDL_Rect dst = tile.rect;
-                dst.y -= cameraY;
-
-                SDL_SetRenderDrawColor(gRenderer, tile.color.r, tile.color.g, tile.color.b, tile.color.a);
-                SDL_RenderFillRect(gRenderer, &dst);
-
-                SDL_SetRenderDrawColor(gRenderer, 0, 0, 0, 255); 
-                SDL_RenderDrawRect(gRenderer, &dst);
-            }
-
-            if (perfectTimer > 0) {
-                perfectTimer -= int(delta * 1000);
-                if (perfectTimer < 0) perfectTimer = 0;
-
-                SDL_Color c = {255,215,0, 255}; 
-                SDL_Texture* txt = renderText("Perfect +5", c);
-                if (txt) {
-                    int tw, th;
-                    SDL_QueryTexture(txt, nullptr, nullptr, &tw, &th);
-                    SDL_Rect trg = { (WINDOW_WIDTH-tw)/2, WINDOW_HEIGHT / 3, tw, th };
-                    SDL_RenderCopy(gRenderer, txt, nullptr, &trg);
-                    SDL_DestroyTexture(txt);
-                }
-            }
-
-            SDL_Rect mr = MUTE_BTN_RECT;
-            SDL_Texture* ico = gMute ? gIconMute : gIconUnmute;
-            if (ico) SDL_RenderCopy(gRenderer, ico, nullptr, &mr);
 
+        bool render = !gMinimized && (gNeedRedraw || !isStaticScreen());
+        Uint64 presentTicks = 0, paceTicks = 0;
+        if (render) {
+            renderFrame(cameraY, alpha);
+            ProfileScope scope(gProfiler, PHASE_PRESENT);
+            showWindowOnce();
+            Uint64 presentStart = SDL_GetPerformanceCounter();
             SDL_RenderPresent(gRenderer);
-        } else if (gState == GameState::GAME_OVER) {
-            SDL_Color black = {0, 0, 0, 255}; 
-            SDL_Texture* overTex = renderText("Game Over", black);
-            if (overTex) {
-                int ow, oh;
-                SDL_QueryTexture(overTex, nullptr, nullptr, &ow, &oh);
-                SDL_Rect orc = {(WINDOW_WIDTH - ow) / 2, WINDOW_HEIGHT / 2 - 60, ow, oh};
-                SDL_RenderCopy(gRenderer, overTex, nullptr, &orc);
-                SDL_DestroyTexture(overTex);
-            }
+            presentTicks = SDL_GetPerformanceCounter() - presentStart;
+            gNeedRedraw = false;
+        }
+        if (render) {
+            ProfileScope scope(gProfiler, PHASE_WAIT);
+            Uint64 paceStart = SDL_GetPerformanceCounter();
+            waitNextFrame(gPacer);
+            paceTicks = SDL_GetPerformanceCounter() - paceStart;
+        }
+        // Vòng lặp không vẽ không phải frame: bỏ số đo, nhịp frame tính lại từ đây
+        if (render) {
+            endProfiledFrame(gProfiler);
+        } else {
+            discardProfiledFrame(gProfiler);
+            resumeFramePacing(gPacer);
+        }
+        addUsage(gUsage, usageSlot, SDL_GetPerformanceCounter() - loopStart, idleTicks + paceTicks,
+                 presentTicks, render);
+        if (gProfiler.frames == 1) {
+            startupMark("first interactive frame");
+            logStartupTimeline();
+        }
 
-            string s = "Score: " + to_string(score);
-            SDL_Texture* scoreTex = renderText(s, black);
-            if (scoreTex) {
-                int sw, sh;
-                SDL_QueryTexture(scoreTex, nullptr, nullptr, &sw, &sh);
-                SDL_Rect src = {(WINDOW_WIDTH - sw) / 2, WINDOW_HEIGHT / 2 - 20, sw, sh};
-                SDL_RenderCopy(gRenderer, scoreTex, nullptr, &src);
-                SDL_DestroyTexture(scoreTex);
+        // Frame ổn định trong PLAYING không được cấp phát heap
+        uint64_t frameAllocs = allocCount() - allocsBefore;
+        bool steady = gAssetsDone && gState == GameState::PLAYING && frameState == GameState::PLAYING && !gPaused &&
+                      !gBotEnabled;   // tìm kiếm của bot cấp phát, không tính
+        steadyFrames = steady ? steadyFrames + 1 : 0;
+        if (steadyFrames > ALLOC_GUARD_WARMUP_FRAMES &&
+            gTextures.createdThisFrame + gTextures.destroyedThisFrame > 0) {
+            textureChurnFrames++;
+        }
+        if (frameAllocs > 0 && steadyFrames > ALLOC_GUARD_WARMUP_FRAMES) {
+            allocFrames++;
+            maxFrameAllocs = max<Uint64>(maxFrameAllocs, frameAllocs);
+            if (gFailOnAlloc) {
+                SDL_Log("Allocation guard: frame %llu made %llu heap allocations",
+                        (unsigned long long)gProfiler.frames, (unsigned long long)frameAllocs);
+                gExitCode = 1;
+                quit = true;
             }
-
-            string finalTopScore = "Top Score: " + to_string(max(gTopScore, score));
-            SDL_Texture* topScoreText = renderText(finalTopScore, black);
-            if(topScoreText){
-                int tsw, tsh;
-                SDL_QueryTexture(topScoreText, nullptr, nullptr, &tsw, &tsh);
-                SDL_Rect tsr = {(WINDOW_WIDTH - tsw)/2, WINDOW_HEIGHT/2 + 20, tsw, tsh};
-                SDL_RenderCopy(gRenderer, topScoreText, nullptr, &tsr);
-                SDL_DestroyTexture(topScoreText);
-             }
-
-
-            SDL_RenderPresent(gRenderer);
         }
-        SDL_Delay(16); 
+    }
+    if (allocCounterEnabled()) {
+        SDL_Log("Allocation guard: %llu steady frames allocated (max %llu per frame), arena high water %zu bytes",
+                (unsigned long long)allocFrames, (unsigned long long)maxFrameAllocs, gFrameArena.highWater);
+    }
+    shutdownInputClock(gInputClock);
+    logUsageStats(gUsage);
+    if (gBotEnabled && gBot.stats.decisions > 0) {
+        const AutoPlayerStats& bs = gBot.stats;
+        SDL_Log("Bot: %llu decisions, %.0f decisions/s, search depth avg %.2f (min %d, max %d) in %.1f ms budget",
+                (unsigned long long)bs.decisions, bs.decisions / bs.searchSeconds,
+                double(bs.depthSum) / bs.decisions, bs.depthMin, bs.depthMax, gBotConfig.budgetMs);
+    }
+    SDL_Log("Tower store: %zu tiles, %zu history bytes in memory, %zu spilled (%zu bytes), "
+            "%zu dropped",
+            gCore.tiles.size(), towerStoreHistoryBytes(gCore.tiles),
+            gCore.tiles.spilledTiles, gCore.tiles.spilledBytes, gCore.tiles.droppedTiles);
+    towerStoreClose(gCore.tiles);
+    SDL_Log("Screen cache: menu composed %llu times, game over %llu times",
+            (unsigned long long)gMenuScreen.composes, (unsigned long long)gGameOverScreen.composes);
+    logTextureStats(gTextures);
+    if (textureChurnFrames > 0) {
+        SDL_Log("Texture churn: %llu steady frames created or destroyed textures",
+                (unsigned long long)textureChurnFrames);
+    }
+    logFramePacerStats(gPacer);
+    logProfilerSummary(gProfiler);
+    if (gProfileCsvPath && !writeProfilerCsv(gProfiler, gProfileCsvPath)) {
+        SDL_Log("Failed to write %s", gProfileCsvPath);
     }
 }
 
 int main(int argc, char* argv[]) {
+    startupTimelineInit();
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--sim-hz") == 0 && i + 1 < argc) {
+            gSimHz = max(30, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--pacing") == 0 && i + 1 < argc) {
+            if (!parsePacingMode(argv[++i], gPacingMode)) {
+                SDL_Log("Unknown pacing mode '%s' (vsync, uncapped, limit)", argv[i]);
+            }
+        } else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            gPacingHz = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--profile-csv") == 0 && i + 1 < argc) {
+            gProfileCsvPath = argv[++i];
+        } else if (strcmp(argv[i], "--tex-budget-mb") == 0 && i + 1 < argc) {
+            gTextureBudget = size_t(max(1, atoi(argv[++i]))) << 20;
+        } else if (strcmp(argv[i], "--tower-log") == 0 && i + 1 < argc) {
+            // Lịch sử tháp cũ được nén ra file này thay vì file mặc định
+            gCore.tiles.spillPath = argv[++i];
+        } else if (strcmp(argv[i], "--no-tower-log") == 0) {
+            gTowerLog = false;
+        } else if (strcmp(argv[i], "--bot") == 0) {
+            gBotEnabled = true;
+        } else if (strcmp(argv[i], "--bot-jitter") == 0 && i + 1 < argc) {
+            gBotConfig.jitterTicks = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--bot-budget-ms") == 0 && i + 1 < argc) {
+            gBotConfig.budgetMs = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--no-pack") == 0) {
+            gUseAssetPack = false;
+        } else if (strcmp(argv[i], "--fail-on-alloc") == 0) {
+            gFailOnAlloc = true;
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            gTracePath = argv[++i];
+            traceEnable(true);
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            const char* error;
+            if (loadReplay(argv[++i], gPlayback, &error)) {
+                gPlaybackActive = true;
+                gSimHz = gPlayback.tickHz;
+            } else {
+                SDL_Log("Failed to load replay %s: %s", argv[i], error);
+            }
+        }
+    }
+
+    if (!gTowerLog) {
+        gCore.tiles.spillPath = nullptr;
+    } else if (!gCore.tiles.spillPath) {
+        std::error_code ec;
+        std::filesystem::create_directories(TOWER_LOG_DIR, ec);
+        time_t now = time(0);
+        char stamp[32];
+        strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", localtime(&now));
+        snprintf(gTowerLogPath, sizeof(gTowerLogPath), "%s/%s.tcsp", TOWER_LOG_DIR, stamp);
+        gCore.tiles.spillPath = gTowerLogPath;
+    }
+
+    traceSetThreadName("main");
     if (!initSDL()) {
          SDL_Log("Exiting: initSDL failed.");
          return -1;
     }
-    if (!loadAssets()) {
+    int loadStep = startupBegin("loadAssets");
+    bool assetsQueued = loadAssets();
+    startupEnd(loadStep);
+    if (!assetsQueued) {
         SDL_Log("Exiting: loadAssets failed.");
         cleanupSDL(); 
         return -1;
     }
+    if (!runSplash()) {
+        cleanupSDL();
+        return gExitCode;
+    }
 
+    initFrameProfiler(gProfiler);
+    initFrameArena(gFrameArena, FRAME_ARENA_SIZE);
+    if (gBotEnabled) initAutoPlayer(gBot, gBotConfig, SDL_GetPerformanceCounter());
+    filterEvents();
     run();
+    destroyFrameArena(gFrameArena);
+    destroyFrameProfiler(gProfiler);
     cleanupSDL();
-    return 0;
+    if (gTracePath && !traceWrite(gTracePath)) {
+        SDL_Log("Failed to write trace %s", gTracePath);
+    }
+    return gExitCode;
 }
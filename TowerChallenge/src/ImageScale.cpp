@@ -0,0 +1,105 @@
+#include "ImageScale.h"
+
+#include <SDL2/SDL_image.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+
+struct Tap {
+    int index;
+    float weight;
+};
+
+// Mỗi pixel đích phủ đoạn [i*scale, (i+1)*scale) trên trục nguồn; trọng số là
+// phần diện tích giao nhau.
+static vector<vector<Tap>> areaTaps(int srcLen, int dstLen) {
+    vector<vector<Tap>> taps(dstLen);
+    double scale = double(srcLen) / dstLen;
+    for (int i = 0; i < dstLen; i++) {
+        double a = i * scale, b = (i + 1) * scale;
+        double total = 0;
+        for (int s = int(a); s < srcLen && s < b; s++) {
+            double w = min(b, s + 1.0) - max(a, double(s));
+            if (w <= 0) continue;
+            taps[i].push_back({s, float(w)});
+            total += w;
+        }
+        for (Tap& t : taps[i]) t.weight = float(t.weight / total);
+    }
+    return taps;
+}
+
+static float srgbToLinear(float c) {
+    return c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static float linearToSrgb(float c) {
+    return c <= 0.0031308f ? c * 12.92f : 1.055f * powf(c, 1.0f / 2.4f) - 0.055f;
+}
+
+static Uint8 toByte(float v) {
+    return Uint8(min(255.0f, max(0.0f, roundf(v * 255.0f))));
+}
+
+
+SDL_Surface* resampleSurface(SDL_Surface* src, int dw, int dh) {
+    SDL_Surface* rgba = SDL_ConvertSurfaceFormat(src, SDL_PIXELFORMAT_RGBA32, 0);
+    if (!rgba) return nullptr;
+    SDL_Surface* dst = SDL_CreateRGBSurfaceWithFormat(0, dw, dh, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!dst) {
+        SDL_FreeSurface(rgba);
+        return nullptr;
+    }
+
+    float toLinear[256];
+    for (int i = 0; i < 256; i++) toLinear[i] = srgbToLinear(i / 255.0f);
+
+    // Lọc ngang từ thẳng dữ liệu nguồn, rồi lọc dọc trên bộ đệm float
+    int sw = rgba->w, sh = rgba->h;
+    vector<vector<Tap>> tapsX = areaTaps(sw, dw), tapsY = areaTaps(sh, dh);
+    vector<float> horiz(size_t(dw) * sh * 4, 0.0f);
+    for (int y = 0; y < sh; y++) {
+        const Uint8* row = (const Uint8*)rgba->pixels + size_t(y) * rgba->pitch;
+        for (int x = 0; x < dw; x++) {
+            float* out = &horiz[(size_t(y) * dw + x) * 4];
+            for (const Tap& t : tapsX[x]) {
+                const Uint8* p = row + t.index * 4;
+                float a = p[3] / 255.0f * t.weight;
+                out[0] += toLinear[p[0]] * a;
+                out[1] += toLinear[p[1]] * a;
+                out[2] += toLinear[p[2]] * a;
+                out[3] += a;
+            }
+        }
+    }
+    SDL_FreeSurface(rgba);
+
+    for (int y = 0; y < dh; y++) {
+        Uint8* row = (Uint8*)dst->pixels + size_t(y) * dst->pitch;
+        for (int x = 0; x < dw; x++) {
+            float acc[4] = {0, 0, 0, 0};
+            for (const Tap& t : tapsY[y]) {
+                const float* in = &horiz[(size_t(t.index) * dw + x) * 4];
+                for (int c = 0; c < 4; c++) acc[c] += in[c] * t.weight;
+            }
+            Uint8* out = row + x * 4;
+            float a = acc[3];
+            for (int c = 0; c < 3; c++) out[c] = a > 0 ? toByte(linearToSrgb(acc[c] / a)) : 0;
+            out[3] = toByte(a);
+        }
+    }
+    return dst;
+}
+
+SDL_Surface* loadImageScaled(const char* path, int w, int h) {
+    SDL_Surface* loaded = IMG_Load(path);
+    if (!loaded) return nullptr;
+    SDL_Surface* out = (w > 0 && h > 0) ? resampleSurface(loaded, w, h)
+                                        : SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(loaded);
+    return out;
+}
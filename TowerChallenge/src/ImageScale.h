@@ -0,0 +1,15 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+// Thu nhỏ ảnh một lần lúc nạp về đúng kích thước được vẽ. Bộ lọc trung bình
+// diện tích (box) tính trong không gian màu tuyến tính trên alpha nhân sẵn:
+// không răng cưa khi thu nhỏ mạnh (icon 4000px -> 40px), không tối màu ở các
+// chi tiết mảnh và không lem viền trong suốt. Dành cho thu nhỏ; phóng to thì
+// cho kết quả gần như lân cận gần nhất.
+
+// Trả về surface mới SDL_PIXELFORMAT_RGBA32 kích thước w x h (src giữ nguyên).
+SDL_Surface* resampleSurface(SDL_Surface* src, int w, int h);
+
+// IMG_Load rồi thu nhỏ; w hoặc h <= 0 thì chỉ đổi sang RGBA32.
+SDL_Surface* loadImageScaled(const char* path, int w, int h);
@@ -0,0 +1,53 @@
+#include "InputClock.h"
+
+
+static bool isStamped(Uint32 type) {
+    return type == SDL_MOUSEBUTTONDOWN || type == SDL_KEYDOWN;
+}
+
+// Chạy trong SDL_PushEvent, trên luồng đang bơm sự kiện
+static int SDLCALL watchInput(void* userdata, SDL_Event* e) {
+    if (!isStamped(e->type)) return 0;
+    InputClock& clock = *static_cast<InputClock*>(userdata);
+    Uint64 counter = SDL_GetPerformanceCounter();
+    SDL_AtomicLock(&clock.lock);
+    // Đầy thì bỏ dấu mới; sự kiện đó sẽ dùng fallback
+    if (clock.head - clock.tail < Uint32(INPUT_CLOCK_SLOTS)) {
+        clock.stamps[clock.head & (INPUT_CLOCK_SLOTS - 1)] = {e->type, e->common.timestamp, counter};
+        clock.head++;
+    }
+    SDL_AtomicUnlock(&clock.lock);
+    return 0;
+}
+
+
+void initInputClock(InputClock& clock) {
+    clock.head = clock.tail = 0;
+    SDL_AddEventWatch(watchInput, &clock);
+    clock.installed = true;
+}
+
+void shutdownInputClock(InputClock& clock) {
+    if (!clock.installed) return;
+    SDL_DelEventWatch(watchInput, &clock);
+    clock.installed = false;
+}
+
+Uint64 inputEventCounter(InputClock& clock, const SDL_Event& e, Uint64 fallback) {
+    if (!isStamped(e.type)) return fallback;
+    Uint64 counter = fallback;
+    SDL_AtomicLock(&clock.lock);
+    while (clock.tail != clock.head) {
+        const InputStamp& s = clock.stamps[clock.tail & (INPUT_CLOCK_SLOTS - 1)];
+        // Dấu mới hơn sự kiện: sự kiện này không có dấu, giữ dấu cho lần sau
+        if (SDL_TICKS_PASSED(s.timestamp, e.common.timestamp) && s.timestamp != e.common.timestamp) break;
+        clock.tail++;
+        if (s.type == e.type && s.timestamp == e.common.timestamp) {
+            counter = s.counter;
+            break;
+        }
+        // Còn lại là dấu của sự kiện đã bị bỏ khỏi hàng đợi: bỏ qua
+    }
+    SDL_AtomicUnlock(&clock.lock);
+    return counter;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+// Đóng dấu thời gian độ phân giải cao cho input. e.common.timestamp của SDL2
+// chỉ là SDL_GetTicks() lúc sự kiện được đưa vào hàng đợi (ms), nên một event
+// watch ghi SDL_GetPerformanceCounter() ngay lúc đó cho mỗi lần bấm chuột/phím.
+// Độ chính xác vẫn giới hạn bởi lần bơm sự kiện (SDL_PumpEvents) gần nhất:
+// bơm càng thường (FramePacer bơm cả khi ngủ chờ frame) thì mốc càng sát.
+//
+// Dấu được xếp FIFO theo đúng thứ tự hàng đợi SDL; inputEventCounter phải
+// được gọi cho MỌI SDL_MOUSEBUTTONDOWN/SDL_KEYDOWN lấy ra, kể cả khi bỏ qua.
+
+const int INPUT_CLOCK_SLOTS = 64;   // lũy thừa của 2
+
+struct InputStamp {
+    Uint32 type;
+    Uint32 timestamp;   // e.common.timestamp, để khớp với sự kiện
+    Uint64 counter;
+};
+
+struct InputClock {
+    InputStamp stamps[INPUT_CLOCK_SLOTS];
+    Uint32 head = 0;    // số dấu đã ghi
+    Uint32 tail = 0;    // số dấu đã lấy
+    SDL_SpinLock lock = 0;
+    bool installed = false;
+};
+
+void initInputClock(InputClock& clock);
+void shutdownInputClock(InputClock& clock);
+
+// Performance counter lúc e vào hàng đợi; fallback nếu không tìm thấy dấu
+// (hàng dấu tràn, sự kiện tự đẩy bằng SDL_PushEvent trước khi cài...).
+Uint64 inputEventCounter(InputClock& clock, const SDL_Event& e, Uint64 fallback);
@@ -0,0 +1,54 @@
+#include "ScreenCache.h"
+
+
+bool initScreenCache(ScreenCache& cache, TextureManager& textures, const char* name,
+                     int width, int height) {
+    destroyScreenCache(cache, textures);
+    cache.name = name;
+    cache.width = width;
+    cache.height = height;
+    if (!SDL_RenderTargetSupported(textures.renderer)) return false;
+
+    cache.handle = createTexture(textures, name, SDL_PIXELFORMAT_RGBA8888,
+                                 SDL_TEXTUREACCESS_TARGET, width, height);
+    cache.tex = textureGet(textures, cache.handle);
+    if (!cache.tex) {
+        textureRelease(textures, cache.handle);
+        return false;
+    }
+    // Màn hình phủ kín, copy không cần trộn màu
+    SDL_SetTextureBlendMode(cache.tex, SDL_BLENDMODE_NONE);
+    return true;
+}
+
+void destroyScreenCache(ScreenCache& cache, TextureManager& textures) {
+    textureRelease(textures, cache.handle);
+    cache.tex = nullptr;
+    cache.valid = false;
+}
+
+void invalidateScreenCache(ScreenCache& cache) {
+    cache.valid = false;
+}
+
+
+void drawScreenCache(SDL_Renderer* renderer, ScreenCache& cache, uint64_t key, void (*compose)()) {
+    if (!cache.tex) {
+        compose();
+        return;
+    }
+    if (!cache.valid || cache.key != key) {
+        SDL_Texture* prevTarget = SDL_GetRenderTarget(renderer);
+        if (SDL_SetRenderTarget(renderer, cache.tex) != 0) {
+            SDL_Log("SDL_SetRenderTarget error (%s): %s", cache.name, SDL_GetError());
+            compose();
+            return;
+        }
+        compose();
+        SDL_SetRenderTarget(renderer, prevTarget);
+        cache.valid = true;
+        cache.key = key;
+        cache.composes++;
+    }
+    SDL_RenderCopy(renderer, cache.tex, nullptr, nullptr);
+}
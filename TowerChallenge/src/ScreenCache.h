@@ -0,0 +1,36 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <cstdint>
+
+#include "TextureManager.h"
+
+// Màn hình tĩnh (menu, game over) được ghép một lần vào một render target,
+// sau đó mỗi frame chỉ tốn một SDL_RenderCopy. Nội dung gắn với một key do
+// người gọi tính từ các đầu vào của màn hình (top score, mute, điểm...):
+// key đổi thì ghép lại. Mất render target (SDL_RENDER_TARGETS_RESET) chỉ cần
+// invalidate, mất thiết bị (SDL_RENDER_DEVICE_RESET) thì tạo lại texture;
+// cả hai đều ghép lại từ trạng thái phía CPU ở lần vẽ sau.
+
+struct ScreenCache {
+    TextureHandle handle = NO_TEXTURE;
+    SDL_Texture* tex = nullptr;     // render target, không bị evict
+    const char* name = nullptr;
+    int width = 0;
+    int height = 0;
+    bool valid = false;
+    uint64_t key = 0;
+    Uint64 composes = 0;
+};
+
+// false nếu renderer không có render target; drawScreenCache khi đó vẽ thẳng.
+bool initScreenCache(ScreenCache& cache, TextureManager& textures, const char* name,
+                     int width, int height);
+void destroyScreenCache(ScreenCache& cache, TextureManager& textures);
+
+void invalidateScreenCache(ScreenCache& cache);
+
+// Vẽ màn hình; compose() chỉ được gọi khi key khác lần ghép trước hoặc nội
+// dung đã bị mất. compose vẽ vào render target hiện hành, phủ kín màn hình.
+void drawScreenCache(SDL_Renderer* renderer, ScreenCache& cache, uint64_t key, void (*compose)());
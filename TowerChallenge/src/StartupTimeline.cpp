@@ -0,0 +1,79 @@
+#include "StartupTimeline.h"
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "Trace.h"
+
+using namespace std;
+
+struct StartupStep {
+    const char* name;
+    Uint64 begin;
+    Uint64 end;        // == begin với mốc tức thời
+    bool mainThread;
+    bool instant;
+};
+
+static StartupStep gSteps[STARTUP_MAX_STEPS];
+static atomic<int> gStepCount{0};
+static Uint64 gStartupOrigin = 0;
+static SDL_threadID gMainThread = 0;
+
+
+void startupTimelineInit() {
+    gStartupOrigin = SDL_GetPerformanceCounter();
+    gMainThread = SDL_ThreadID();
+}
+
+static int addStep(const char* name, bool instant) {
+    int i = gStepCount.fetch_add(1, memory_order_relaxed);
+    if (i >= STARTUP_MAX_STEPS) return -1;
+    StartupStep& s = gSteps[i];
+    s.name = name;
+    s.begin = s.end = SDL_GetPerformanceCounter();
+    s.mainThread = SDL_ThreadID() == gMainThread;
+    s.instant = instant;
+    return i;
+}
+
+int startupBegin(const char* name) {
+    traceBegin(name);
+    return addStep(name, false);
+}
+
+void startupEnd(int step) {
+    if (step < 0) return;
+    gSteps[step].end = SDL_GetPerformanceCounter();
+    traceEnd(gSteps[step].name);
+}
+
+void startupMark(const char* name) {
+    traceInstant(name);
+    addStep(name, true);
+}
+
+
+void logStartupTimeline() {
+    int n = min(gStepCount.load(), STARTUP_MAX_STEPS);
+    StartupStep sorted[STARTUP_MAX_STEPS];
+    copy(gSteps, gSteps + n, sorted);
+    stable_sort(sorted, sorted + n, [](const StartupStep& a, const StartupStep& b) {
+        return a.begin < b.begin;
+    });
+
+    double toMs = 1000.0 / SDL_GetPerformanceFrequency();
+    SDL_Log("Startup timeline (ms since launch):");
+    for (int i = 0; i < n; i++) {
+        const StartupStep& s = sorted[i];
+        double b = (s.begin - gStartupOrigin) * toMs;
+        if (s.instant) {
+            SDL_Log("  %8.1f            %-24s %s", b, s.name, s.mainThread ? "main" : "worker");
+        } else {
+            SDL_Log("  %8.1f %8.1f ms  %-24s %s", b, (s.end - s.begin) * toMs, s.name,
+                    s.mainThread ? "main" : "worker");
+        }
+    }
+}
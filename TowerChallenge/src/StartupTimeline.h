@@ -0,0 +1,15 @@
+#pragma once
+
+// Dòng thời gian khởi động: đo từng bước từ lúc chạy chương trình tới frame
+// tương tác đầu tiên, kể cả các bước chạy trên luồng khác. Luôn bật (chỉ vài
+// chục mục), đồng thời ghi ra trace nếu có --trace. Tên bước phải là chuỗi hằng.
+
+const int STARTUP_MAX_STEPS = 64;
+
+void startupTimelineInit();          // gọi đầu tiên trong main
+int startupBegin(const char* name);  // trả về chỉ số để truyền cho startupEnd
+void startupEnd(int step);
+void startupMark(const char* name);  // mốc tức thời
+
+// In bảng các bước; gọi sau khi mọi luồng khởi động đã join.
+void logStartupTimeline();
@@ -0,0 +1,162 @@
+#include "TextAtlas.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+const int TEXT_ATLAS_WIDTH = 512;
+const int TEXT_ATLAS_PADDING = 1;
+const int TEXT_MAX_QUADS = 256;   // đủ cho mọi chuỗi trong game, không cấp phát lại
+
+
+static int glyphIndex(char c) {
+    int ch = (unsigned char)c;
+    if (ch < TEXT_ATLAS_FIRST_CHAR || ch > TEXT_ATLAS_LAST_CHAR) ch = '?';
+    return ch - TEXT_ATLAS_FIRST_CHAR;
+}
+
+static int kerning(const TextAtlas& atlas, int prevIdx, int idx) {
+    if (prevIdx < 0) return 0;
+    return TTF_GetFontKerningSizeGlyphs32(atlas.font,
+                                          Uint32(prevIdx + TEXT_ATLAS_FIRST_CHAR),
+                                          Uint32(idx + TEXT_ATLAS_FIRST_CHAR));
+}
+
+
+bool buildTextAtlas(TextAtlas& atlas, TextureManager& textures, TTF_Font* font) {
+    destroyTextAtlas(atlas, textures);
+    if (!font) return false;
+
+    const SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface* glyphSurf[TEXT_ATLAS_GLYPH_COUNT] = {};
+
+    // Raster từng glyph và xếp theo hàng để tính kích thước atlas
+    int penX = 0, penY = 0, rowH = 0;
+    for (int i = 0; i < TEXT_ATLAS_GLYPH_COUNT; i++) {
+        Uint32 ch = Uint32(i + TEXT_ATLAS_FIRST_CHAR);
+        GlyphInfo& g = atlas.glyphs[i];
+        g.src = {0, 0, 0, 0};
+        g.advance = 0;
+
+        int minx, maxx, miny, maxy;
+        if (TTF_GlyphMetrics32(font, ch, &minx, &maxx, &miny, &maxy, &g.advance) != 0) {
+            continue;
+        }
+        if (ch == ' ') continue;
+
+        glyphSurf[i] = TTF_RenderGlyph32_Blended(font, ch, white);
+        if (!glyphSurf[i]) continue;
+
+        int w = glyphSurf[i]->w, h = glyphSurf[i]->h;
+        if (penX + w + TEXT_ATLAS_PADDING > TEXT_ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowH + TEXT_ATLAS_PADDING;
+            rowH = 0;
+        }
+        g.src = {penX, penY, w, h};
+        penX += w + TEXT_ATLAS_PADDING;
+        rowH = max(rowH, h);
+    }
+    int atlasH = penY + rowH;
+
+    SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat(0, TEXT_ATLAS_WIDTH, max(atlasH, 1),
+                                                        32, SDL_PIXELFORMAT_ARGB8888);
+    if (!sheet) {
+        SDL_Log("Text atlas surface error: %s", SDL_GetError());
+        for (SDL_Surface* s : glyphSurf) if (s) SDL_FreeSurface(s);
+        return false;
+    }
+    SDL_FillRect(sheet, nullptr, SDL_MapRGBA(sheet->format, 255, 255, 255, 0));
+
+    for (int i = 0; i < TEXT_ATLAS_GLYPH_COUNT; i++) {
+        if (!glyphSurf[i]) continue;
+        // Chép nguyên kênh alpha vào atlas, không hoà trộn
+        SDL_SetSurfaceBlendMode(glyphSurf[i], SDL_BLENDMODE_NONE);
+        SDL_Rect dst = atlas.glyphs[i].src;
+        SDL_BlitSurface(glyphSurf[i], nullptr, sheet, &dst);
+        SDL_FreeSurface(glyphSurf[i]);
+    }
+
+    atlas.handle = createTextureFromSurface(textures, "textAtlas", sheet);
+    SDL_FreeSurface(sheet);
+    atlas.tex = textureGet(textures, atlas.handle);
+    if (!atlas.tex) return false;
+    SDL_SetTextureBlendMode(atlas.tex, SDL_BLENDMODE_BLEND);
+
+    atlas.font = font;
+    atlas.texW = TEXT_ATLAS_WIDTH;
+    atlas.texH = max(atlasH, 1);
+    atlas.lineHeight = TTF_FontHeight(font);
+    return true;
+}
+
+void destroyTextAtlas(TextAtlas& atlas, TextureManager& textures) {
+    textureRelease(textures, atlas.handle);
+    atlas.tex = nullptr;
+    atlas.font = nullptr;
+}
+
+
+void measureText(const TextAtlas& atlas, const char* text, int* w, int* h) {
+    int width = 0, prev = -1;
+    for (const char* p = text; *p; p++) {
+        int idx = glyphIndex(*p);
+        width += kerning(atlas, prev, idx) + atlas.glyphs[idx].advance;
+        prev = idx;
+    }
+    if (w) *w = width;
+    if (h) *h = atlas.lineHeight;
+}
+
+void drawText(SDL_Renderer* renderer, const TextAtlas& atlas, const char* text,
+              int x, int y, SDL_Color color) {
+    if (!atlas.tex) return;
+
+    // Bộ đệm dùng lại giữa các lần gọi, chỉ cấp phát khi chuỗi dài hơn trước
+    static vector<SDL_Vertex> verts;
+    static vector<int> indices;
+    if (verts.capacity() == 0) {
+        verts.reserve(TEXT_MAX_QUADS * 4);
+        indices.reserve(TEXT_MAX_QUADS * 6);
+    }
+    verts.clear();
+    indices.clear();
+
+    float invW = 1.0f / atlas.texW, invH = 1.0f / atlas.texH;
+    int penX = x, prev = -1;
+    for (const char* p = text; *p; p++) {
+        int idx = glyphIndex(*p);
+        const GlyphInfo& g = atlas.glyphs[idx];
+        penX += kerning(atlas, prev, idx);
+        prev = idx;
+
+        if (g.src.w > 0) {
+            float x0 = float(penX), y0 = float(y);
+            float x1 = x0 + g.src.w, y1 = y0 + g.src.h;
+            float u0 = g.src.x * invW, v0 = g.src.y * invH;
+            float u1 = (g.src.x + g.src.w) * invW, v1 = (g.src.y + g.src.h) * invH;
+
+            int base = int(verts.size());
+            verts.push_back({{x0, y0}, color, {u0, v0}});
+            verts.push_back({{x1, y0}, color, {u1, v0}});
+            verts.push_back({{x1, y1}, color, {u1, v1}});
+            verts.push_back({{x0, y1}, color, {u0, v1}});
+            int quad[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+        penX += g.advance;
+    }
+
+    if (!verts.empty()) {
+        SDL_RenderGeometry(renderer, atlas.tex, verts.data(), int(verts.size()),
+                           indices.data(), int(indices.size()));
+    }
+}
+
+void drawTextCentered(SDL_Renderer* renderer, const TextAtlas& atlas, const char* text,
+                      int areaW, int y, SDL_Color color) {
+    int w;
+    measureText(atlas, text, &w, nullptr);
+    drawText(renderer, atlas, text, (areaW - w) / 2, y, color);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include "TextureManager.h"
+
+// Atlas chữ: raster toàn bộ ký tự ASCII in được của font một lần duy nhất
+// vào một texture, sau đó mỗi chuỗi được vẽ bằng một lô quad lấy từ atlas
+// (một lệnh SDL_RenderGeometry, không tạo texture mới mỗi frame).
+
+const int TEXT_ATLAS_FIRST_CHAR = 32;
+const int TEXT_ATLAS_LAST_CHAR = 126;
+const int TEXT_ATLAS_GLYPH_COUNT = TEXT_ATLAS_LAST_CHAR - TEXT_ATLAS_FIRST_CHAR + 1;
+
+struct GlyphInfo {
+    SDL_Rect src;   // vùng của glyph trong atlas
+    int advance;    // khoảng tiến của bút sau glyph
+};
+
+struct TextAtlas {
+    TextureHandle handle = NO_TEXTURE;
+    SDL_Texture* tex = nullptr;     // không bị evict, giữ con trỏ để vẽ nhanh
+    TTF_Font* font = nullptr;
+    int texW = 0;
+    int texH = 0;
+    int lineHeight = 0;
+    GlyphInfo glyphs[TEXT_ATLAS_GLYPH_COUNT];
+};
+
+bool buildTextAtlas(TextAtlas& atlas, TextureManager& textures, TTF_Font* font);
+void destroyTextAtlas(TextAtlas& atlas, TextureManager& textures);
+
+// Kích thước chuỗi khi vẽ bằng atlas (giống TTF_SizeText).
+void measureText(const TextAtlas& atlas, const char* text, int* w, int* h);
+
+// Vẽ chuỗi với góc trên trái tại (x, y), màu được nhân vào glyph trắng.
+void drawText(SDL_Renderer* renderer, const TextAtlas& atlas, const char* text,
+              int x, int y, SDL_Color color);
+
+// Vẽ chuỗi căn giữa theo chiều ngang trong cửa sổ rộng areaW.
+void drawTextCentered(SDL_Renderer* renderer, const TextAtlas& atlas, const char* text,
+                      int areaW, int y, SDL_Color color);
@@ -0,0 +1,178 @@
+#include "TextureManager.h"
+
+#include <SDL2/SDL_image.h>
+
+#include <cstdio>
+
+#include "AssetPack.h"
+#include "ImageScale.h"
+
+
+static TextureEntry* lookup(TextureManager& tm, TextureHandle h) {
+    if (h == NO_TEXTURE) return nullptr;
+    int index = int(h & 0xFFFF) - 1;
+    if (index < 0 || index >= TEXTURE_MANAGER_SLOTS) return nullptr;
+    TextureEntry& e = tm.entries[index];
+    if (e.refs == 0 || e.generation != uint16_t(h >> 16)) return nullptr;
+    return &e;
+}
+
+static size_t textureBytes(SDL_Texture* tex, int* w, int* h) {
+    Uint32 format;
+    if (SDL_QueryTexture(tex, &format, nullptr, w, h) != 0) return 0;
+    int bpp = SDL_ISPIXELFORMAT_FOURCC(format) ? 4 : SDL_BYTESPERPIXEL(format);
+    return size_t(*w) * *h * bpp;
+}
+
+// Đưa tex vào/ra khỏi GPU và cập nhật các bộ đếm
+static void attach(TextureManager& tm, TextureEntry& e, SDL_Texture* tex) {
+    e.tex = tex;
+    e.bytes = textureBytes(tex, &e.w, &e.h);
+    e.lastUse = tm.frame;
+    tm.bytes += e.bytes;
+    if (tm.bytes > tm.peakBytes) tm.peakBytes = tm.bytes;
+    tm.createdThisFrame++;
+    tm.totalCreated++;
+}
+
+static void detach(TextureManager& tm, TextureEntry& e) {
+    if (!e.tex) return;
+    SDL_DestroyTexture(e.tex);
+    e.tex = nullptr;
+    tm.bytes -= e.bytes;
+    tm.destroyedThisFrame++;
+    tm.totalDestroyed++;
+}
+
+// Nạp lại đúng kích thước cũ (ảnh đã được thu nhỏ lúc nạp lần đầu)
+static SDL_Texture* reload(TextureManager& tm, const TextureEntry& e) {
+    SDL_Texture* tex = tm.pack ? packTexture(tm.renderer, *tm.pack, e.name) : nullptr;
+    if (tex) return tex;
+    char path[256];
+    snprintf(path, sizeof(path), "assets/%s", e.name);
+    SDL_Surface* surf = loadImageScaled(path, e.w, e.h);
+    if (surf) {
+        tex = SDL_CreateTextureFromSurface(tm.renderer, surf);
+        SDL_FreeSurface(surf);
+    }
+    if (!tex) {
+        SDL_Log("Failed to reload texture %s: %s", e.name, IMG_GetError());
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    return tex;
+}
+
+
+void initTextureManager(TextureManager& tm, SDL_Renderer* renderer, size_t budget) {
+    tm = TextureManager();
+    tm.renderer = renderer;
+    tm.budget = budget;
+}
+
+void destroyTextureManager(TextureManager& tm) {
+    for (TextureEntry& e : tm.entries) {
+        if (e.refs == 0) continue;
+        SDL_Log("Texture leak: %s (%d refs, %zu bytes)", e.name ? e.name : "?", e.refs, e.bytes);
+        detach(tm, e);
+        e.refs = 0;
+    }
+    tm.live = 0;
+}
+
+
+TextureHandle adoptTexture(TextureManager& tm, SDL_Texture* tex, const char* name, bool reloadable) {
+    if (!tex) return NO_TEXTURE;
+    for (int i = 0; i < TEXTURE_MANAGER_SLOTS; i++) {
+        TextureEntry& e = tm.entries[i];
+        if (e.refs != 0) continue;
+        e.generation++;
+        e.name = name;
+        e.refs = 1;
+        e.reloadable = reloadable;
+        attach(tm, e, tex);
+        tm.live++;
+        return (TextureHandle(e.generation) << 16) | TextureHandle(i + 1);
+    }
+    SDL_Log("Texture manager full, dropping %s", name ? name : "?");
+    SDL_DestroyTexture(tex);
+    return NO_TEXTURE;
+}
+
+TextureHandle createTexture(TextureManager& tm, const char* name, Uint32 format, int access,
+                            int w, int h) {
+    SDL_Texture* tex = SDL_CreateTexture(tm.renderer, format, access, w, h);
+    if (!tex) {
+        SDL_Log("Failed to create texture %s: %s", name, SDL_GetError());
+        return NO_TEXTURE;
+    }
+    return adoptTexture(tm, tex, name, false);
+}
+
+TextureHandle createTextureFromSurface(TextureManager& tm, const char* name, SDL_Surface* surface) {
+    SDL_Texture* tex = SDL_CreateTextureFromSurface(tm.renderer, surface);
+    if (!tex) {
+        SDL_Log("Failed to create texture %s: %s", name, SDL_GetError());
+        return NO_TEXTURE;
+    }
+    return adoptTexture(tm, tex, name, false);
+}
+
+void textureAddRef(TextureManager& tm, TextureHandle h) {
+    TextureEntry* e = lookup(tm, h);
+    if (e) e->refs++;
+}
+
+void textureRelease(TextureManager& tm, TextureHandle& h) {
+    TextureEntry* e = lookup(tm, h);
+    h = NO_TEXTURE;
+    if (!e || --e->refs > 0) return;
+    detach(tm, *e);
+    e->name = nullptr;
+    tm.live--;
+}
+
+SDL_Texture* textureGet(TextureManager& tm, TextureHandle h) {
+    TextureEntry* e = lookup(tm, h);
+    if (!e) return nullptr;
+    e->lastUse = tm.frame;
+    if (!e->tex && e->reloadable) {
+        SDL_Texture* tex = reload(tm, *e);
+        if (tex) attach(tm, *e, tex);
+    }
+    return e->tex;
+}
+
+void textureManagerDeviceReset(TextureManager& tm) {
+    for (TextureEntry& e : tm.entries) {
+        if (e.refs != 0 && e.reloadable) detach(tm, e);
+    }
+}
+
+
+void beginTextureFrame(TextureManager& tm) {
+    tm.createdLastFrame = tm.createdThisFrame;
+    tm.destroyedLastFrame = tm.destroyedThisFrame;
+    tm.createdThisFrame = tm.destroyedThisFrame = 0;
+    tm.frame++;
+
+    // Evict theo LRU, chỉ những texture nạp lại được và không dùng ở frame trước
+    while (tm.bytes > tm.budget) {
+        TextureEntry* victim = nullptr;
+        for (TextureEntry& e : tm.entries) {
+            if (e.refs == 0 || !e.tex || !e.reloadable || e.lastUse + 1 >= tm.frame) continue;
+            if (!victim || e.lastUse < victim->lastUse) victim = &e;
+        }
+        if (!victim) break;
+        detach(tm, *victim);
+        tm.evictions++;
+    }
+}
+
+void logTextureStats(const TextureManager& tm) {
+    SDL_Log("Textures: %d live, %.2f MB resident (peak %.2f MB, budget %.0f MB), "
+            "%llu created, %llu destroyed, %llu evicted",
+            tm.live, tm.bytes / 1048576.0, tm.peakBytes / 1048576.0, tm.budget / 1048576.0,
+            (unsigned long long)tm.totalCreated, (unsigned long long)tm.totalDestroyed,
+            (unsigned long long)tm.evictions);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <cstddef>
+#include <cstdint>
+
+struct AssetPack;
+
+// Quản lý mọi texture GPU của game: truy cập qua handle, đếm tham chiếu, tính
+// số byte của từng texture, giới hạn tổng dung lượng (budget) bằng cách đẩy ra
+// (evict) các texture nạp lại được ít dùng nhất, và đếm số lần tạo/huỷ mỗi
+// frame để lộ ngay việc upload lặp lại hoặc rò rỉ.
+//
+// Texture nạp lại được (ảnh trong assets/) có thể bị evict bất cứ lúc nào
+// ngoài frame đang dùng nó; textureGet sẽ nạp lại đồng bộ. Texture không nạp
+// lại được (render target, atlas chữ) không bao giờ bị evict nên con trỏ
+// SDL_Texture* của chúng giữ nguyên tới khi release.
+
+typedef uint32_t TextureHandle;   // 0 = không có texture
+const TextureHandle NO_TEXTURE = 0;
+
+const int TEXTURE_MANAGER_SLOTS = 64;
+const size_t DEFAULT_TEXTURE_BUDGET = size_t(256) << 20;
+
+struct TextureEntry {
+    SDL_Texture* tex = nullptr;
+    const char* name = nullptr;     // tên asset (chuỗi hằng) với texture nạp lại được
+    size_t bytes = 0;
+    int w = 0;                      // kích thước lúc adopt, dùng khi nạp lại
+    int h = 0;
+    int refs = 0;                   // 0 = slot trống
+    bool reloadable = false;
+    uint16_t generation = 0;
+    Uint64 lastUse = 0;             // frame dùng gần nhất
+};
+
+struct TextureManager {
+    SDL_Renderer* renderer = nullptr;
+    const AssetPack* pack = nullptr;   // nguồn nạp lại, nullptr = chỉ dùng file lẻ
+    TextureEntry entries[TEXTURE_MANAGER_SLOTS];
+    size_t budget = DEFAULT_TEXTURE_BUDGET;
+    size_t bytes = 0;                  // tổng đang nằm trên GPU
+    size_t peakBytes = 0;
+    int live = 0;
+    Uint64 frame = 0;
+    int createdThisFrame = 0;
+    int destroyedThisFrame = 0;
+    int createdLastFrame = 0;
+    int destroyedLastFrame = 0;
+    Uint64 totalCreated = 0;
+    Uint64 totalDestroyed = 0;
+    Uint64 evictions = 0;
+};
+
+void initTextureManager(TextureManager& tm, SDL_Renderer* renderer, size_t budget);
+// Báo các texture còn tham chiếu (rò rỉ) rồi huỷ toàn bộ.
+void destroyTextureManager(TextureManager& tm);
+
+// Nhận quyền sở hữu tex (refs = 1). name phải là chuỗi hằng.
+TextureHandle adoptTexture(TextureManager& tm, SDL_Texture* tex, const char* name, bool reloadable);
+TextureHandle createTexture(TextureManager& tm, const char* name, Uint32 format, int access,
+                            int w, int h);
+TextureHandle createTextureFromSurface(TextureManager& tm, const char* name, SDL_Surface* surface);
+
+void textureAddRef(TextureManager& tm, TextureHandle h);
+// Giảm tham chiếu, huỷ khi về 0; luôn đặt h = NO_TEXTURE.
+void textureRelease(TextureManager& tm, TextureHandle& h);
+
+// Lấy texture để vẽ trong frame này (nạp lại nếu đã bị evict).
+SDL_Texture* textureGet(TextureManager& tm, TextureHandle h);
+
+// SDL_RENDER_DEVICE_RESET: nội dung mọi texture đã mất. Bỏ texture của các
+// mục nạp lại được để textureGet nạp lại; texture không nạp lại được (render
+// target, atlas) thì bên sở hữu phải tạo lại.
+void textureManagerDeviceReset(TextureManager& tm);
+
+// Gọi đầu mỗi frame: chốt bộ đếm của frame trước và evict nếu vượt budget.
+void beginTextureFrame(TextureManager& tm);
+void logTextureStats(const TextureManager& tm);
@@ -0,0 +1,108 @@
+#include "TileBatch.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/TowerCore.h"
+
+using namespace std;
+
+const int TILE_BATCH_QUADS = 5;   // nền + 4 cạnh viền
+const int TILE_BATCH_VERTS = TILE_BATCH_QUADS * 4;
+const int TILE_BATCH_INDICES = TILE_BATCH_QUADS * 6;
+const SDL_Color TILE_OUTLINE_COLOR = {0, 0, 0, 255};
+const int64_t TILE_BATCH_MAX_SHIFT = 1 << 16;
+
+const SDL_Color TILE_PALETTE[] = {
+    {100, 200, 100, 255}, // xanh lá
+    {200, 50, 50, 255}, // đỏ
+    {150, 50, 150, 255},// tím
+    {255, 215,  0, 255}, // vàng
+    {50, 150, 200, 255}  // xanh dương
+};
+
+
+static void writeQuad(SDL_Vertex* v, float x, float y, float w, float h, SDL_Color c) {
+    v[0] = {{x, y}, c, {0, 0}};
+    v[1] = {{x + w, y}, c, {0, 0}};
+    v[2] = {{x + w, y + h}, c, {0, 0}};
+    v[3] = {{x, y + h}, c, {0, 0}};
+}
+
+// Ghi vertex của tile vào slot, theo đúng hình SDL_RenderFillRect + SDL_RenderDrawRect
+static void writeTile(TileBatch& batch, size_t slot, const Tile& tile, int x, int64_t cameraY) {
+    SDL_Vertex* v = &batch.verts[slot * TILE_BATCH_VERTS];
+    float y = float(tile.y - cameraY);
+    float w = float(tile.w), h = float(tile.h);
+
+    writeQuad(v, float(x), y, w, h, TILE_PALETTE[tile.colorIndex]);
+    writeQuad(v + 4, float(x), y, w, 1, TILE_OUTLINE_COLOR);
+    writeQuad(v + 8, float(x), y + h - 1, w, 1, TILE_OUTLINE_COLOR);
+    writeQuad(v + 12, float(x), y + 1, 1, h - 2, TILE_OUTLINE_COLOR);
+    writeQuad(v + 16, float(x + w - 1), y + 1, 1, h - 2, TILE_OUTLINE_COLOR);
+}
+
+static void ensureSlots(TileBatch& batch, size_t slots) {
+    size_t have = batch.verts.size() / TILE_BATCH_VERTS;
+    if (have >= slots) return;
+
+    batch.verts.resize(slots * TILE_BATCH_VERTS);
+    batch.indices.resize(slots * TILE_BATCH_INDICES);
+    for (size_t s = have; s < slots; s++) {
+        int* idx = &batch.indices[s * TILE_BATCH_INDICES];
+        int base = int(s * TILE_BATCH_VERTS);
+        for (int q = 0; q < TILE_BATCH_QUADS; q++) {
+            int b = base + q * 4;
+            int quad[6] = {b, b + 1, b + 2, b, b + 2, b + 3};
+            for (int k = 0; k < 6; k++) idx[q * 6 + k] = quad[k];
+        }
+    }
+}
+
+
+void resetTileBatch(TileBatch& batch) {
+    batch.verts.clear();
+    batch.indices.clear();
+    batch.first = 0;
+    batch.settledTiles = 0;
+    batch.cameraY = 0;
+}
+
+void drawTileBatch(SDL_Renderer* renderer, TileBatch& batch,
+                   const TowerStore& stack, size_t first, size_t last,
+                   int64_t cameraY, double alpha) {
+    if (last > stack.size()) return;
+    first = max(first, stack.hotFirst());
+    if (last <= first) return;
+    size_t count = last - first;
+    size_t settled = count - 1;
+
+    // Ván mới (đoạn ngắn lại), đầu đoạn dịch lên hoặc camera nhảy xa
+    // (dịch vertex float một khoảng lớn sẽ mất chính xác) -> dựng lại từ đầu
+    int64_t cameraJump = batch.cameraY - cameraY;
+    if (first != batch.first || settled < batch.settledTiles ||
+        cameraJump > TILE_BATCH_MAX_SHIFT || cameraJump < -TILE_BATCH_MAX_SHIFT) {
+        resetTileBatch(batch);
+        batch.first = first;
+        batch.cameraY = cameraY;
+    }
+
+    if (cameraY != batch.cameraY) {
+        float dy = float(batch.cameraY - cameraY);
+        for (SDL_Vertex& v : batch.verts) v.position.y += dy;
+        batch.cameraY = cameraY;
+    }
+
+    ensureSlots(batch, count);
+    for (; batch.settledTiles < settled; batch.settledTiles++) {
+        const Tile& t = stack[first + batch.settledTiles];
+        writeTile(batch, batch.settledTiles, t, t.x, cameraY);
+    }
+    const Tile& live = stack[last - 1];
+    double liveX = (live.prevX + (live.posX - live.prevX) * alpha) / TOWER_FP_ONE;
+    writeTile(batch, settled, live, int(lround(liveX)), cameraY);
+
+    SDL_RenderGeometry(renderer, nullptr,
+                       batch.verts.data(), int(count * TILE_BATCH_VERTS),
+                       batch.indices.data(), int(count * TILE_BATCH_INDICES));
+}
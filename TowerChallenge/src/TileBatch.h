@@ -0,0 +1,28 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <vector>
+
+#include "core/TowerStore.h"
+
+// Vẽ cả tháp bằng một lệnh SDL_RenderGeometry: mỗi tile gồm một quad nền
+// mang màu TILE_PALETTE[colorIndex] và bốn quad viền 1px. Vertex của các tile đã đặt
+// được giữ lại giữa các frame, mỗi frame chỉ tính lại tile đang di chuyển
+// (và dịch toàn bộ khi camera đổi vị trí). Batch vẽ đoạn stack[first, last),
+// tile cuối của đoạn được coi là tile đang di chuyển và được nội suy theo alpha.
+
+extern const SDL_Color TILE_PALETTE[];
+
+struct TileBatch {
+    std::vector<SDL_Vertex> verts;
+    std::vector<int> indices;
+    size_t first = 0;          // chỉ số tile ứng với slot 0
+    size_t settledTiles = 0;   // số slot đầu đã có vertex cố định
+    int64_t cameraY = 0;       // camera ứng với toạ độ vertex hiện tại
+};
+
+void resetTileBatch(TileBatch& batch);
+void drawTileBatch(SDL_Renderer* renderer, TileBatch& batch,
+                   const TowerStore& stack, size_t first, size_t last,
+                   int64_t cameraY, double alpha);
@@ -0,0 +1,121 @@
+#include "TowerStrips.h"
+
+using namespace std;
+
+
+bool initTowerStrips(TowerStrips& strips, TextureManager& textures, int width, int tileHeight) {
+    destroyTowerStrips(strips, textures);
+    SDL_Renderer* renderer = textures.renderer;
+    strips.width = width;
+    strips.stripHeight = STRIP_TILES * tileHeight;
+
+    SDL_RendererInfo info;
+    strips.supported = SDL_RenderTargetSupported(renderer) &&
+                       SDL_GetRendererInfo(renderer, &info) == 0 &&
+                       (info.max_texture_height == 0 || info.max_texture_height >= strips.stripHeight);
+    if (!strips.supported) {
+        SDL_Log("Render targets unavailable, drawing tower without baked strips");
+        return false;
+    }
+
+    for (StripSlot& slot : strips.slots) {
+        slot.handle = createTexture(textures, "towerStrip", SDL_PIXELFORMAT_RGBA8888,
+                                    SDL_TEXTUREACCESS_TARGET, width, strips.stripHeight);
+        slot.tex = textureGet(textures, slot.handle);
+        if (!slot.tex) {
+            destroyTowerStrips(strips, textures);
+            return false;
+        }
+        SDL_SetTextureBlendMode(slot.tex, SDL_BLENDMODE_BLEND);
+    }
+    return true;
+}
+
+void destroyTowerStrips(TowerStrips& strips, TextureManager& textures) {
+    for (StripSlot& slot : strips.slots) {
+        textureRelease(textures, slot.handle);
+        slot = StripSlot();
+    }
+    resetTileBatch(strips.bakeBatch);
+    strips.supported = false;
+}
+
+void invalidateTowerStrips(TowerStrips& strips) {
+    for (StripSlot& slot : strips.slots) slot.strip = -1;
+}
+
+
+// Đỉnh của dải k theo toạ độ thế giới (tile cao nhất của dải)
+static int64_t stripTop(const TowerStore& stack, long k) {
+    return stack[(k + 1) * STRIP_TILES - 1].y;
+}
+
+static StripSlot* acquireStrip(SDL_Renderer* renderer, TowerStrips& strips,
+                               const TowerStore& stack, long k) {
+    StripSlot* lru = &strips.slots[0];
+    for (StripSlot& slot : strips.slots) {
+        if (slot.strip == k) {
+            slot.lastUse = strips.frame;
+            return &slot;
+        }
+        if (slot.strip < 0 || (lru->strip >= 0 && slot.lastUse < lru->lastUse)) lru = &slot;
+    }
+
+    // Bake dải vào texture của slot ít dùng nhất
+    SDL_Texture* prevTarget = SDL_GetRenderTarget(renderer);
+    if (SDL_SetRenderTarget(renderer, lru->tex) != 0) {
+        SDL_Log("SDL_SetRenderTarget error: %s", SDL_GetError());
+        return nullptr;
+    }
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    size_t first = size_t(k) * STRIP_TILES;
+    drawTileBatch(renderer, strips.bakeBatch, stack, first, first + STRIP_TILES,
+                  stripTop(stack, k), 0.0);
+    SDL_SetRenderTarget(renderer, prevTarget);
+
+    lru->strip = k;
+    lru->lastUse = strips.frame;
+    return lru;
+}
+
+// Tile thấp nhất còn trên màn hình: phần tháp dưới đáy khung nhìn bị cắt bỏ
+static size_t firstOnScreen(const TowerStore& stack, size_t settled, int64_t cameraY, int viewH) {
+    size_t first = settled;
+    while (first > stack.hotFirst() && stack[first - 1].y - cameraY < viewH) first--;
+    return first;
+}
+
+size_t drawTowerStrips(SDL_Renderer* renderer, TowerStrips& strips,
+                       const TowerStore& stack, int64_t cameraY, int viewH) {
+    if (stack.empty()) return 0;
+    size_t settled = stack.size() - 1;
+    strips.frame++;
+
+    // Không có render target: TileBatch vẽ thẳng phần còn trên màn hình
+    if (!strips.supported) return firstOnScreen(stack, settled, cameraY, viewH);
+
+    long fullStrips = long(settled / STRIP_TILES);
+    // Chỉ bake được các dải còn nằm trọn trong cửa sổ nóng của TowerStore
+    long oldest = long((stack.hotFirst() + STRIP_TILES - 1) / STRIP_TILES);
+    // Bake hết các dải trong khung nhìn trước rồi mới vẽ: một dải bake lỗi thì
+    // cả phần tháp trên màn hình do TileBatch vẽ, không mất dải nào, không vẽ hai lần
+    StripSlot* ready[STRIP_CACHE_SLOTS];
+    int tops[STRIP_CACHE_SLOTS];
+    int count = 0;
+    for (long k = fullStrips - 1; k >= oldest; k--) {
+        int64_t top64 = stripTop(stack, k) - cameraY;
+        if (top64 >= viewH) break;                        // các dải thấp hơn đều ngoài màn hình
+        if (top64 + strips.stripHeight <= 0) continue;    // nằm trên khung nhìn
+
+        StripSlot* slot = count < STRIP_CACHE_SLOTS ? acquireStrip(renderer, strips, stack, k) : nullptr;
+        if (!slot) return firstOnScreen(stack, settled, cameraY, viewH);
+        ready[count] = slot;
+        tops[count++] = int(top64);
+    }
+    for (int i = 0; i < count; i++) {
+        SDL_Rect dst = {0, tops[i], strips.width, strips.stripHeight};
+        SDL_RenderCopy(renderer, ready[i]->tex, nullptr, &dst);
+    }
+    return size_t(fullStrips) * STRIP_TILES;
+}
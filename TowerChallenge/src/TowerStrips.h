@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include "core/TowerStore.h"
+#include "TileBatch.h"
+#include "TextureManager.h"
+
+// Phần tháp đã đặt xong được bake thành các dải (strip) render-target,
+// mỗi dải STRIP_TILES tile. Mỗi frame chỉ vẽ các dải giao với cửa sổ camera,
+// nên chi phí vẽ không phụ thuộc chiều cao tháp. Texture của dải được lấy
+// từ một cache nhỏ (LRU) và bake lại khi cần, nên bộ nhớ VRAM cũng cố định.
+
+const int STRIP_TILES = 64;
+const int STRIP_CACHE_SLOTS = 3;
+
+struct StripSlot {
+    TextureHandle handle = NO_TEXTURE;
+    SDL_Texture* tex = nullptr;   // render target, không bị evict
+    long strip = -1;        // dải đang nằm trong texture, -1 = trống
+    Uint32 lastUse = 0;
+};
+
+struct TowerStrips {
+    StripSlot slots[STRIP_CACHE_SLOTS];
+    TileBatch bakeBatch;
+    int width = 0;
+    int stripHeight = 0;
+    bool supported = false;
+    Uint32 frame = 0;
+};
+
+bool initTowerStrips(TowerStrips& strips, TextureManager& textures, int width, int tileHeight);
+void destroyTowerStrips(TowerStrips& strips, TextureManager& textures);
+
+// Bỏ nội dung mọi texture (ván mới, hoặc SDL_RENDER_TARGETS_RESET).
+void invalidateTowerStrips(TowerStrips& strips);
+
+// Vẽ các dải đã bake nằm trong khung nhìn [cameraY, cameraY + viewH).
+// Trả về chỉ số tile đầu tiên phải vẽ trực tiếp bằng TileBatch (cả phần
+// tháp trên màn hình nếu không bake được dải nào đó).
+size_t drawTowerStrips(SDL_Renderer* renderer, TowerStrips& strips,
+                       const TowerStore& stack, int64_t cameraY, int viewH);
@@ -0,0 +1,139 @@
+#include "Trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+struct TraceEvent {
+    const char* name;
+    int64_t tsNs;
+    char phase;   // 'B', 'E', 'i'
+};
+
+// Ô của vòng tròn: luồng ghi có thể đang ghi đè đúng ô traceWrite đang chép,
+// nên mọi trường là atomic (relaxed, trên x86 vẫn chỉ là mov thường) và bản
+// chép được kiểm lại bằng count như seqlock
+struct TraceSlot {
+    atomic<const char*> name;
+    atomic<int64_t> tsNs;
+    atomic<char> phase;
+};
+
+struct TraceBuffer {
+    TraceSlot events[TRACE_EVENTS_PER_THREAD];
+    atomic<uint64_t> count{0};   // tổng số sự kiện đã ghi; ô = count & (N - 1)
+    atomic<const char*> threadName{nullptr};
+    int tid = 0;
+};
+
+static atomic<bool> gTraceOn{false};
+static const chrono::steady_clock::time_point gTraceEpoch = chrono::steady_clock::now();
+static mutex gTraceRegistryMutex;
+static vector<unique_ptr<TraceBuffer>> gTraceBuffers;
+static thread_local TraceBuffer* tTraceBuffer = nullptr;
+
+
+static TraceBuffer* threadBuffer() {
+    if (!tTraceBuffer) {
+        unique_ptr<TraceBuffer> buf(new TraceBuffer);   // không xoá trắng mảng sự kiện
+        lock_guard<mutex> lock(gTraceRegistryMutex);
+        buf->tid = int(gTraceBuffers.size()) + 1;
+        tTraceBuffer = buf.get();
+        gTraceBuffers.push_back(move(buf));
+    }
+    return tTraceBuffer;
+}
+
+static void record(const char* name, char phase) {
+    if (!gTraceOn.load(memory_order_relaxed)) return;
+    TraceBuffer* buf = threadBuffer();
+
+    uint64_t n = buf->count.load(memory_order_relaxed);
+    TraceSlot& ev = buf->events[n & (TRACE_EVENTS_PER_THREAD - 1)];
+    int64_t ts = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - gTraceEpoch).count();
+    // Ai đọc thấy nội dung mới của ô thì cũng thấy count >= n (cặp với fence acquire ở traceWrite)
+    atomic_thread_fence(memory_order_release);
+    ev.name.store(name, memory_order_relaxed);
+    ev.tsNs.store(ts, memory_order_relaxed);
+    ev.phase.store(phase, memory_order_relaxed);
+    // Phát hành sự kiện cho luồng đọc sau khi đã ghi xong nội dung
+    buf->count.store(n + 1, memory_order_release);
+}
+
+
+void traceEnable(bool enabled) { gTraceOn = enabled; }
+bool traceEnabled() { return gTraceOn; }
+
+void traceBegin(const char* name) { record(name, 'B'); }
+void traceEnd(const char* name) { record(name, 'E'); }
+void traceInstant(const char* name) { record(name, 'i'); }
+
+void traceSetThreadName(const char* name) {
+    if (!gTraceOn) return;
+    threadBuffer()->threadName.store(name, memory_order_relaxed);
+}
+
+
+bool traceWrite(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    uint64_t overwritten = 0;
+    vector<TraceEvent> events;
+
+    lock_guard<mutex> lock(gTraceRegistryMutex);
+    for (const unique_ptr<TraceBuffer>& buf : gTraceBuffers) {
+        const char* threadName = buf->threadName.load(memory_order_relaxed);
+        if (threadName) {
+            fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                    first ? "" : ",\n", buf->tid, threadName);
+            first = false;
+        }
+
+        // Chép ra trước rồi đọc lại count: luồng ghi vẫn chạy và có thể đã
+        // ghi đè đầu cửa sổ trong lúc chép. Bỏ các ô đã bị ghi đè (< after)
+        // và cả ô của lần ghi đang dở (chỉ số after), có thể chép phải nửa chừng
+        const uint64_t cap = TRACE_EVENTS_PER_THREAD;
+        uint64_t end = buf->count.load(memory_order_acquire);
+        uint64_t begin = end > cap ? end - cap : 0;
+        events.clear();
+        for (uint64_t i = begin; i < end; i++) {
+            const TraceSlot& slot = buf->events[i & (cap - 1)];
+            events.push_back({slot.name.load(memory_order_relaxed), slot.tsNs.load(memory_order_relaxed),
+                              slot.phase.load(memory_order_relaxed)});
+        }
+        atomic_thread_fence(memory_order_acquire);
+        uint64_t after = buf->count.load(memory_order_relaxed);
+        uint64_t valid = after + 1 > cap ? min(end, max(begin, after + 1 - cap)) : begin;
+        overwritten += valid;
+
+        // Bỏ các 'E' mà 'B' tương ứng đã bị ghi đè
+        int depth = 0;
+        for (uint64_t i = valid; i < end; i++) {
+            const TraceEvent& ev = events[i - begin];
+            if (ev.phase == 'B') depth++;
+            if (ev.phase == 'E' && depth-- <= 0) {
+                depth = 0;
+                continue;
+            }
+            fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d%s}",
+                    first ? "" : ",\n", ev.name, ev.phase, ev.tsNs / 1000.0, buf->tid,
+                    ev.phase == 'i' ? ",\"s\":\"t\"" : "");
+            first = false;
+        }
+    }
+    fprintf(f, "\n]}\n");
+
+    if (overwritten > 0) {
+        fprintf(stderr, "trace: %llu older events overwritten (ring buffer)\n", (unsigned long long)overwritten);
+    }
+    return fclose(f) == 0;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+// Ghi trace dạng Chrome trace event (mở được bằng Perfetto / chrome://tracing).
+// Mỗi luồng ghi vào bộ đệm riêng có dung lượng cố định, không khoá; chỉ lần
+// ghi đầu tiên của một luồng mới phải đăng ký bộ đệm. Tên zone phải là chuỗi
+// hằng (chỉ lưu con trỏ). Bộ đệm là vòng tròn: khi đầy thì ghi đè sự kiện cũ
+// nhất, nên bấm F9 lúc nào cũng lấy được TRACE_EVENTS_PER_THREAD sự kiện mới nhất.
+
+const int TRACE_EVENTS_PER_THREAD = 1 << 18;   // lũy thừa của 2
+
+void traceEnable(bool enabled);
+bool traceEnabled();
+
+void traceBegin(const char* name);
+void traceEnd(const char* name);
+void traceInstant(const char* name);
+void traceSetThreadName(const char* name);
+
+// Ghi các sự kiện còn trong bộ đệm ra file JSON, cũ trước mới sau (có thể gọi nhiều lần).
+bool traceWrite(const char* path);
+
+struct TraceScope {
+    const char* name;
+    explicit TraceScope(const char* n) : name(n) { traceBegin(name); }
+    ~TraceScope() { traceEnd(name); }
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name)
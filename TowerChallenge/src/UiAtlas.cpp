@@ -0,0 +1,56 @@
+#include "UiAtlas.h"
+
+#include <SDL2/SDL_image.h>
+
+#include <algorithm>
+#include <cstdio>
+
+#include "ImageScale.h"
+
+using namespace std;
+
+const int UI_ATLAS_PADDING = 1;
+
+// Kích thước vẽ trong Game.cpp: nút mute 40x40, nút start cao 50
+const UiSpriteSpec UI_SPRITES[UI_SPRITE_COUNT] = {
+    {"images/icon_mute.png", 40, 40},
+    {"images/icon_unmute.png", 40, 40},
+    {"images/start_button.png", 50, 50},
+};
+
+
+void layoutUiAtlas(SDL_Rect rects[UI_SPRITE_COUNT], int* atlasW, int* atlasH) {
+    int x = 0, h = 0;
+    for (int i = 0; i < UI_SPRITE_COUNT; i++) {
+        rects[i] = {x, 0, UI_SPRITES[i].w, UI_SPRITES[i].h};
+        x += UI_SPRITES[i].w + UI_ATLAS_PADDING;
+        h = max(h, UI_SPRITES[i].h);
+    }
+    *atlasW = x - UI_ATLAS_PADDING;
+    *atlasH = h;
+}
+
+SDL_Surface* buildUiAtlasSurface(const char* assetsDir) {
+    SDL_Rect rects[UI_SPRITE_COUNT];
+    int w, h;
+    layoutUiAtlas(rects, &w, &h);
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!atlas) return nullptr;
+    SDL_FillRect(atlas, nullptr, 0);
+
+    for (int i = 0; i < UI_SPRITE_COUNT; i++) {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/%s", assetsDir, UI_SPRITES[i].file);
+        SDL_Surface* sprite = loadImageScaled(path, rects[i].w, rects[i].h);
+        if (!sprite) {
+            SDL_Log("Failed to load %s: %s", path, IMG_GetError());
+            SDL_FreeSurface(atlas);
+            return nullptr;
+        }
+        // Chép nguyên pixel kể cả alpha, không hoà trộn
+        SDL_SetSurfaceBlendMode(sprite, SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(sprite, nullptr, atlas, &rects[i]);
+        SDL_FreeSurface(sprite);
+    }
+    return atlas;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+// Atlas ảnh UI nhỏ: các icon mute/unmute và start_button.png được thu nhỏ về
+// kích thước vẽ rồi xếp vào một texture duy nhất. Bố cục cố định, tính bằng
+// layoutUiAtlas ở cả tools/pack_assets lẫn lúc chạy nên không cần lưu kèm.
+
+enum UiSprite { UI_ICON_MUTE, UI_ICON_UNMUTE, UI_START_BUTTON, UI_SPRITE_COUNT };
+
+const char* const UI_ATLAS_NAME = "ui_atlas";   // tên mục trong assets.pack
+
+struct UiSpriteSpec {
+    const char* file;   // trong assets/
+    int w;
+    int h;
+};
+
+extern const UiSpriteSpec UI_SPRITES[UI_SPRITE_COUNT];
+
+void layoutUiAtlas(SDL_Rect rects[UI_SPRITE_COUNT], int* atlasW, int* atlasH);
+
+// Nạp, thu nhỏ và ghép các ảnh UI thành một surface RGBA32.
+SDL_Surface* buildUiAtlasSurface(const char* assetsDir);
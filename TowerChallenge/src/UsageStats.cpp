@@ -0,0 +1,29 @@
+#include "UsageStats.h"
+
+
+void initUsageStats(UsageStats& stats, const char* const* names, int count) {
+    stats = UsageStats();
+    stats.freq = SDL_GetPerformanceFrequency();
+    for (int i = 0; i < count && i < USAGE_SLOTS; i++) stats.slots[i].name = names[i];
+}
+
+void addUsage(UsageStats& stats, int slot, Uint64 wall, Uint64 idle, Uint64 present, bool presented) {
+    if (slot < 0 || slot >= USAGE_SLOTS) return;
+    UsageSlot& s = stats.slots[slot];
+    s.wall += wall;
+    s.idle += idle;
+    s.present += present;
+    s.loops++;
+    if (presented) s.presented++;
+}
+
+void logUsageStats(const UsageStats& stats) {
+    for (const UsageSlot& s : stats.slots) {
+        if (!s.name || s.wall == 0) continue;
+        double seconds = double(s.wall) / stats.freq;
+        Uint64 busy = s.wall - s.idle - s.present;
+        SDL_Log("Usage %-9s %7.1f s, %llu loops, %llu presents (%.1f fps), CPU busy %.1f%%, present %.1f%%",
+                s.name, seconds, (unsigned long long)s.loops, (unsigned long long)s.presented,
+                s.presented / seconds, 100.0 * busy / s.wall, 100.0 * s.present / s.wall);
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+// Thống kê mức dùng CPU/GPU theo trạng thái (menu, đang chơi, tạm dừng...).
+// Thời gian mỗi vòng lặp được chia thành: chờ (ngủ trong SDL_WaitEventTimeout
+// hoặc bộ điều nhịp), present (luồng chính bị chặn trong SDL_RenderPresent,
+// đại diện cho tải GPU/vsync), phần còn lại là CPU bận.
+
+const int USAGE_SLOTS = 8;
+
+struct UsageSlot {
+    const char* name = nullptr;
+    Uint64 wall = 0;
+    Uint64 idle = 0;
+    Uint64 present = 0;
+    Uint64 loops = 0;
+    Uint64 presented = 0;
+};
+
+struct UsageStats {
+    UsageSlot slots[USAGE_SLOTS];
+    Uint64 freq = 0;
+};
+
+void initUsageStats(UsageStats& stats, const char* const* names, int count);
+void addUsage(UsageStats& stats, int slot, Uint64 wall, Uint64 idle, Uint64 present, bool presented);
+void logUsageStats(const UsageStats& stats);
@@ -0,0 +1,208 @@
+#include "AutoPlayer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+// Phân phối chuẩn xấp xỉ bằng 5 điểm: 0, ±σ, ±2σ
+const double NOISE_OFFSETS[AUTOPLAYER_NOISE_SAMPLES] = {0.0, -1.0, 1.0, -2.0, 2.0};
+const double NOISE_WEIGHTS[AUTOPLAYER_NOISE_SAMPLES] = {0.408, 0.242, 0.242, 0.054, 0.054};
+const uint32_t MAX_LOOKAHEAD_TICKS = 65535;   // fraction Q16 của towerTileXAfter là uint32
+
+
+struct SearchContext {
+    const AutoPlayerConfig* config = nullptr;
+    int tickHz = TOWER_TICK_HZ;
+    TowerRules rules;                  // luật của core đang chơi
+    int samples = 1;
+    int64_t noise[AUTOPLAYER_NOISE_SAMPLES] = {};   // độ lệch thời điểm, Q16 tick
+    unordered_map<uint64_t, double> memo;
+    uint64_t nodes = 0;
+    atomic<bool>* abort = nullptr;
+    bool useDeadline = false;
+    Clock::time_point deadline;
+
+    bool aborted() {
+        if (abort->load(memory_order_relaxed)) return true;
+        if (useDeadline && (nodes & 63) == 0 && Clock::now() > deadline) {
+            abort->store(true, memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+};
+
+static void initContext(SearchContext& ctx, const AutoPlayerConfig& config, const TowerCore& core) {
+    ctx.config = &config;
+    ctx.tickHz = core.tickHz;
+    ctx.rules = core.rules;
+    ctx.samples = config.jitterTicks > 0 ? AUTOPLAYER_NOISE_SAMPLES : 1;
+    for (int s = 0; s < ctx.samples; s++) {
+        ctx.noise[s] = llround(NOISE_OFFSETS[s] * config.jitterTicks * TOWER_FP_ONE);
+    }
+}
+
+// Số tick của một chu kỳ qua lại: mọi vị trí đều lặp lại sau chừng đó
+static uint32_t periodTicks(int w, int speed, int tickHz) {
+    int range = TOWER_WIDTH - w;
+    if (range <= 0 || speed <= 0) return 1;
+    int64_t ticks = (int64_t(2 * range) * tickHz << TOWER_SPEED_SHIFT) / speed + 1;
+    return uint32_t(min<int64_t>(ticks, MAX_LOOKAHEAD_TICKS));
+}
+
+// Khoảng lệch (px) mà tay bấm có thể gây ra; ngoài khoảng này là trượt chắc
+static int slackPx(const SearchContext& ctx, int speed) {
+    double pxPerTick = double(speed) / (1 << TOWER_SPEED_SHIFT) / ctx.tickHz;
+    return int(ceil(2.0 * ctx.config->jitterTicks * pxPerTick)) + 1;
+}
+
+static int landingX(const Tile& t, int tickHz, int64_t when) {
+    return (towerTileXAfter(t, tickHz, uint32_t(max<int64_t>(0, when)), nullptr) + TOWER_FP_ONE / 2)
+           >> TOWER_FP_SHIFT;
+}
+
+static double stateValue(SearchContext& ctx, int prevX, int w, int speed, int depth);
+
+// Điểm kỳ vọng khi nhắm thả tile t tại thời điểm aim (Q16 tick kể từ trạng thái của t)
+static double evalDrop(SearchContext& ctx, const Tile& t, int prevX, int prevW, int64_t aim, int depth) {
+    double value = 0.0;
+    for (int s = 0; s < ctx.samples; s++) {
+        int x = landingX(t, ctx.tickHz, aim + ctx.noise[s]);
+        int outX, outW;
+        TowerDropResult r = towerResolveDrop(prevX, prevW, x, t.w, &outX, &outW,
+                                             ctx.rules.perfectTolerance);
+        ctx.nodes++;
+        if (r == TOWER_DROP_MISS) continue;
+
+        double gain = r == TOWER_DROP_PERFECT ? PERFECT_BONUS : 1;
+        int speed = r == TOWER_DROP_PERFECT ? t.speed
+                                            : min(ctx.rules.maxSpeed, t.speed + ctx.rules.speedIncrement);
+        double weight = ctx.samples > 1 ? NOISE_WEIGHTS[s] : 1.0;
+        value += weight * (gain + stateValue(ctx, outX, outW, speed, depth - 1));
+    }
+    return value;
+}
+
+// Giá trị kỳ vọng của tháp có tile trên cùng (prevX, w) và tile mới sắp chạy
+static double stateValue(SearchContext& ctx, int prevX, int w, int speed, int depth) {
+    if (depth <= 0) return w * ctx.config->widthValue;
+    uint64_t key = uint64_t(prevX) | (uint64_t(w) << 10) | (uint64_t(speed) << 20) |
+                   (uint64_t(depth) << 48);
+    auto it = ctx.memo.find(key);
+    if (it != ctx.memo.end()) return it->second;
+    if (ctx.aborted()) return 0.0;
+
+    // Tile mới luôn xuất phát ở x = 0 (hướng nào cũng cùng pha)
+    Tile t = {};
+    t.w = w;
+    t.h = TILE_HEIGHT;
+    t.speed = speed;
+    t.movingRight = true;
+
+    // Nhìn trước chỉ cần ước lượng: với độ lệch đối xứng, nhắm lệch khỏi tile
+    // dưới không bao giờ tốt hơn nhắm thẳng, nên chỉ thử các tick gần prevX
+    int window = slackPx(ctx, speed) + ctx.rules.perfectTolerance;
+    uint32_t n = periodTicks(w, speed, ctx.tickHz);
+    double best = 0.0;
+    for (uint32_t k = 0; k < n; k++) {
+        int64_t aim = int64_t(k) << TOWER_FP_SHIFT;
+        if (abs(landingX(t, ctx.tickHz, aim) - prevX) > window) continue;
+        best = max(best, evalDrop(ctx, t, prevX, w, aim, depth));
+    }
+    ctx.memo[key] = best;
+    return best;
+}
+
+
+void initAutoPlayer(AutoPlayer& bot, const AutoPlayerConfig& config, uint64_t seed) {
+    bot.config = config;
+    bot.pool.reset(new JobPool(config.threads));
+    bot.rng.seed(seed);
+    bot.stats = AutoPlayerStats();
+}
+
+bool autoPlayerDecide(AutoPlayer& bot, const TowerCore& core, AutoPlayerPlan& plan) {
+    if (core.gameOver || core.tiles.size() < 2) return false;
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start + chrono::duration_cast<Clock::duration>(
+                                             chrono::duration<double, milli>(bot.config.budgetMs));
+
+    const Tile& curr = core.tiles.back();
+    const Tile& prev = core.tiles[core.tiles.size() - 2];
+    uint32_t candidates = periodTicks(curr.w, curr.speed, core.tickHz) * AUTOPLAYER_ROOT_STEPS;
+    size_t chunks = min<size_t>(candidates, size_t(bot.pool->workerCount()) * 4);
+
+    struct ChunkResult {
+        double value;
+        int64_t aim;
+        uint64_t nodes;
+    };
+    vector<ChunkResult> results(chunks);
+
+    plan = AutoPlayerPlan();
+    for (int depth = 1; depth <= max(1, bot.config.maxDepth); depth++) {
+        atomic<bool> abort(false);
+        parallelFor(*bot.pool, chunks, [&](size_t i) {
+            SearchContext ctx;
+            initContext(ctx, bot.config, core);
+            ctx.abort = &abort;
+            ctx.useDeadline = depth > 1;
+            ctx.deadline = deadline;
+
+            int slack = slackPx(ctx, curr.speed);
+            ChunkResult r = {-1.0, 0, 0};
+            for (uint32_t c = uint32_t(i * candidates / chunks); c < (i + 1) * candidates / chunks; c++) {
+                int64_t aim = int64_t(c) * TOWER_FP_ONE / AUTOPLAYER_ROOT_STEPS;
+                if (r.value >= 0 && abs(landingX(curr, core.tickHz, aim) - prev.x) >= curr.w + slack) continue;
+                double v = evalDrop(ctx, curr, prev.x, prev.w, aim, depth);
+                if (v > r.value) {
+                    r.value = v;
+                    r.aim = aim;
+                }
+            }
+            r.nodes = ctx.nodes;
+            results[i] = r;
+        });
+        for (const ChunkResult& r : results) bot.stats.nodes += r.nodes;
+        if (abort) break;
+
+        // Các khối theo thứ tự thời gian: giá trị bằng nhau thì thả sớm hơn
+        const ChunkResult* best = &results[0];
+        for (const ChunkResult& r : results) {
+            if (r.value > best->value) best = &r;
+        }
+        plan.tick = core.tick + uint64_t(best->aim >> TOWER_FP_SHIFT);
+        plan.fraction = uint32_t(best->aim & (TOWER_FP_ONE - 1));
+        plan.expected = best->value;
+        plan.depth = depth;
+        if (Clock::now() > deadline) break;
+    }
+
+    AutoPlayerStats& s = bot.stats;
+    s.searchSeconds += chrono::duration<double>(Clock::now() - start).count();
+    s.depthSum += plan.depth;
+    s.depthMin = s.decisions == 0 ? plan.depth : min(s.depthMin, plan.depth);
+    s.depthMax = max(s.depthMax, plan.depth);
+    s.decisions++;
+    return true;
+}
+
+void autoPlayerJitter(AutoPlayer& bot, const TowerCore& core, AutoPlayerPlan& plan) {
+    if (bot.config.jitterTicks <= 0) return;
+    // Box-Muller
+    double u1 = (bot.rng.nextU32() + 0.5) / 4294967296.0;
+    double u2 = (bot.rng.nextU32() + 0.5) / 4294967296.0;
+    double z = sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+
+    int64_t when = int64_t(plan.tick - core.tick) * TOWER_FP_ONE + plan.fraction +
+                   llround(z * bot.config.jitterTicks * TOWER_FP_ONE);
+    when = max<int64_t>(0, when);
+    plan.tick = core.tick + uint64_t(when >> TOWER_FP_SHIFT);
+    plan.fraction = uint32_t(when & (TOWER_FP_ONE - 1));
+}
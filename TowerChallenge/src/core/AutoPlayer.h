@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "JobPool.h"
+#include "Random.h"
+#include "TowerCore.h"
+
+// Bot chơi bằng đúng luật của tower_core, cho attract mode và load test.
+// Với tile đang chạy, bot thử mọi thời điểm thả trong một chu kỳ chuyển động
+// (bước 1/AUTOPLAYER_ROOT_STEPS tick), tính điểm kỳ vọng khi tay bấm bị lệch
+// ngẫu nhiên (phân phối chuẩn, độ lệch jitterTicks) rồi nhìn trước các tile
+// sau: tile mới luôn xuất phát từ x = 0 nên chuyển động của nó chỉ phụ thuộc
+// bề rộng và tốc độ, giá trị mỗi trạng thái (x, w, tốc độ) được nhớ lại.
+// Tầng gốc chia ra các nhân qua JobPool; độ sâu tăng dần tới khi hết ngân
+// sách thời gian (iterative deepening), lấy kết quả của tầng sâu nhất đã xong.
+
+const int AUTOPLAYER_ROOT_STEPS = 4;        // số điểm thả thử trong mỗi tick ở tầng gốc
+const int AUTOPLAYER_NOISE_SAMPLES = 5;
+
+struct AutoPlayerConfig {
+    double jitterTicks = 6.0;      // độ lệch chuẩn của tay bấm (tick), 0 = bấm chính xác
+    double widthValue = 0.05;      // giá trị ước lượng mỗi px bề rộng ở lá của cây tìm kiếm
+    int maxDepth = 4;              // số tile nhìn trước tối đa (tính cả tile đang chạy)
+    double budgetMs = 4.0;         // ngân sách mỗi quyết định; tầng 1 luôn chạy hết
+    int threads = 0;               // 0 = số nhân CPU
+};
+
+struct AutoPlayerPlan {
+    uint64_t tick = 0;             // thả tại tick + fraction / TOWER_FP_ONE
+    uint32_t fraction = 0;
+    double expected = 0.0;         // điểm kỳ vọng của nước đi theo mô hình
+    int depth = 0;                 // độ sâu đã tìm xong
+};
+
+struct AutoPlayerStats {
+    uint64_t decisions = 0;
+    uint64_t nodes = 0;            // số lần thử thả đã đánh giá
+    double searchSeconds = 0.0;
+    uint64_t depthSum = 0;
+    int depthMin = 0;
+    int depthMax = 0;
+};
+
+struct AutoPlayer {
+    AutoPlayerConfig config;
+    std::unique_ptr<JobPool> pool;
+    Pcg32 rng;                     // độ lệch tay bấm khi thực hiện nước đi
+    AutoPlayerStats stats;
+};
+
+void initAutoPlayer(AutoPlayer& bot, const AutoPlayerConfig& config, uint64_t seed);
+
+// Tìm thời điểm thả tốt nhất cho tile đang chạy. false nếu ván đã kết thúc.
+bool autoPlayerDecide(AutoPlayer& bot, const TowerCore& core, AutoPlayerPlan& plan);
+
+// Cộng độ lệch tay bấm vào kế hoạch (không sớm hơn tick hiện tại của core).
+void autoPlayerJitter(AutoPlayer& bot, const TowerCore& core, AutoPlayerPlan& plan);
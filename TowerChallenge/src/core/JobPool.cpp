@@ -0,0 +1,106 @@
+#include "JobPool.h"
+
+#include <algorithm>
+
+using namespace std;
+
+static thread_local int tWorkerIndex = -1;
+static thread_local const void* tWorkerPool = nullptr;
+
+
+JobPool::JobPool(int threads) : queues(threads > 0 ? threads : max(1u, thread::hardware_concurrency())) {
+    int n = int(queues.size());
+    workers.reserve(n);
+    for (int i = 0; i < n; i++) {
+        workers.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+JobPool::~JobPool() {
+    wait();
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    workReady.notify_all();
+    for (thread& t : workers) t.join();
+}
+
+
+void JobPool::submit(function<void()> job) {
+    int n = int(queues.size());
+    int target = (tWorkerPool == this) ? tWorkerIndex : int(nextQueue++ % n);
+
+    pending++;
+    {
+        lock_guard<mutex> lock(queues[target].mutex);
+        queues[target].jobs.push_back(move(job));
+    }
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        queued++;
+    }
+    workReady.notify_one();
+}
+
+void JobPool::wait() {
+    unique_lock<mutex> lock(sleepMutex);
+    allDone.wait(lock, [this] { return pending == 0; });
+}
+
+
+bool JobPool::popLocal(int self, function<void()>& job) {
+    Queue& q = queues[self];
+    lock_guard<mutex> lock(q.mutex);
+    if (q.jobs.empty()) return false;
+    job = move(q.jobs.back());
+    q.jobs.pop_back();
+    return true;
+}
+
+bool JobPool::steal(int self, function<void()>& job) {
+    int n = int(queues.size());
+    for (int k = 1; k < n; k++) {
+        Queue& q = queues[(self + k) % n];
+        lock_guard<mutex> lock(q.mutex);
+        if (q.jobs.empty()) continue;
+        job = move(q.jobs.front());
+        q.jobs.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void JobPool::workerLoop(int self) {
+    tWorkerIndex = self;
+    tWorkerPool = this;
+
+    for (;;) {
+        function<void()> job;
+        if (popLocal(self, job) || steal(self, job)) {
+            queued--;
+            job();
+            if (--pending == 0) {
+                lock_guard<mutex> lock(sleepMutex);
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        unique_lock<mutex> lock(sleepMutex);
+        workReady.wait(lock, [this] { return stopping || queued > 0; });
+        if (stopping && queued == 0) return;
+    }
+}
+
+
+void parallelFor(JobPool& pool, size_t count, const function<void(size_t)>& fn, size_t grain) {
+    grain = max<size_t>(1, grain);
+    for (size_t begin = 0; begin < count; begin += grain) {
+        size_t end = min(count, begin + grain);
+        pool.submit([&fn, begin, end] {
+            for (size_t i = begin; i < end; i++) fn(i);
+        });
+    }
+    pool.wait();
+}
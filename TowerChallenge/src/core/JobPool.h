@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool luồng kiểu work-stealing: mỗi worker có hàng đợi riêng, lấy việc từ
+// cuối hàng của mình và khi rảnh thì "trộm" việc ở đầu hàng của worker khác.
+// Việc tạo ra từ trong một worker được đẩy vào hàng của chính worker đó.
+class JobPool {
+public:
+    explicit JobPool(int threads = 0);   // 0 = số nhân CPU
+    ~JobPool();
+
+    JobPool(const JobPool&) = delete;
+    JobPool& operator=(const JobPool&) = delete;
+
+    void submit(std::function<void()> job);
+    void wait();                          // chờ tới khi mọi việc đã xong
+    int workerCount() const { return int(workers.size()); }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> jobs;
+    };
+
+    bool popLocal(int self, std::function<void()>& job);
+    bool steal(int self, std::function<void()>& job);
+    void workerLoop(int self);
+
+    std::vector<std::thread> workers;
+    std::vector<Queue> queues;
+    std::atomic<long> queued{0};       // việc đang nằm trong hàng đợi (có thể âm tạm thời)
+    std::atomic<size_t> pending{0};    // việc chưa chạy xong
+    std::atomic<size_t> nextQueue{0};
+    std::mutex sleepMutex;
+    std::condition_variable workReady;
+    std::condition_variable allDone;
+    bool stopping = false;
+};
+
+// Chia [0, count) thành các khối và chạy fn(i) song song trên pool.
+void parallelFor(JobPool& pool, size_t count, const std::function<void(size_t)>& fn,
+                 size_t grain = 1);
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+#include "TowerCore.h"
+
+// PCG32 (XSH RR): nhỏ, nhanh, gieo hạt được. Mỗi ván giữ một bộ sinh riêng
+// nên không còn trạng thái ẩn toàn cục như rand().
+struct Pcg32 : TowerRng {
+    uint64_t state = 0;
+    uint64_t inc = 1;
+
+    Pcg32() {}
+    explicit Pcg32(uint64_t seedValue, uint64_t stream = 0x9E3779B97F4A7C15ULL) { seed(seedValue, stream); }
+
+    void seed(uint64_t seedValue, uint64_t stream = 0x9E3779B97F4A7C15ULL) {
+        state = 0;
+        inc = (stream << 1) | 1;
+        nextU32();
+        state += seedValue;
+        nextU32();
+    }
+
+    uint32_t nextU32() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        uint32_t xorshifted = uint32_t(((old >> 18) ^ old) >> 27);
+        uint32_t rot = uint32_t(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+    }
+
+    uint32_t next() override { return nextU32(); }
+};
@@ -0,0 +1,226 @@
+#include "Replay.h"
+
+#include <cmath>
+#include <cstdio>
+
+#include "Random.h"
+
+using namespace std;
+
+const size_t REPLAY_HEADER_SIZE = 4 + 2 + 2 + 8 + 4 + 4 + 4 + 8;
+
+
+static void putU16(vector<uint8_t>& out, uint16_t v) {
+    out.push_back(uint8_t(v));
+    out.push_back(uint8_t(v >> 8));
+}
+
+static void putU32(vector<uint8_t>& out, uint32_t v) {
+    for (int i = 0; i < 4; i++) out.push_back(uint8_t(v >> (8 * i)));
+}
+
+static void putU64(vector<uint8_t>& out, uint64_t v) {
+    for (int i = 0; i < 8; i++) out.push_back(uint8_t(v >> (8 * i)));
+}
+
+static void putVarint(vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(uint8_t(v) | 0x80);
+        v >>= 7;
+    }
+    out.push_back(uint8_t(v));
+}
+
+struct ByteReader {
+    const uint8_t* p;
+    const uint8_t* end;
+
+    bool u16(uint16_t& v) {
+        if (end - p < 2) return false;
+        v = uint16_t(p[0] | (p[1] << 8));
+        p += 2;
+        return true;
+    }
+    bool u32(uint32_t& v) {
+        if (end - p < 4) return false;
+        v = 0;
+        for (int i = 0; i < 4; i++) v |= uint32_t(p[i]) << (8 * i);
+        p += 4;
+        return true;
+    }
+    bool u64(uint64_t& v) {
+        if (end - p < 8) return false;
+        v = 0;
+        for (int i = 0; i < 8; i++) v |= uint64_t(p[i]) << (8 * i);
+        p += 8;
+        return true;
+    }
+    bool varint(uint64_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p >= end) return false;
+            uint8_t b = *p++;
+            v |= uint64_t(b & 0x7F) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return false;
+    }
+};
+
+
+void beginReplay(Replay& replay, uint64_t seed, int tickHz) {
+    replay.seed = seed;
+    replay.tickHz = tickHz;
+    replay.drops.clear();
+    replay.drops.reserve(TOWER_TILE_RESERVE);
+    replay.finalScore = 0;
+    replay.tileCount = 0;
+    replay.towerHash = 0;
+}
+
+bool replayRecordDrop(Replay& replay, TowerCore& core, double tickFraction) {
+    long q = lround(tickFraction * REPLAY_FRACTION_ONE);
+    if (q < 0) q = 0;
+    if (q >= REPLAY_FRACTION_ONE) q = REPLAY_FRACTION_ONE - 1;
+
+    replay.drops.push_back({core.tick, uint16_t(q)});
+    return towerPlaceTileFixed(core, uint32_t(q));
+}
+
+void finishReplay(Replay& replay, const TowerCore& core) {
+    replay.finalScore = core.score;
+    replay.tileCount = uint32_t(core.tiles.size());
+    replay.towerHash = towerHash(core);
+}
+
+uint64_t towerHash(const TowerCore& core) {
+    // FNV-1a 64 bit; các tile đã rời cửa sổ nóng được gộp sẵn trong historyHash
+    uint64_t h = core.tiles.historyHash;
+    auto mix = [&h](int32_t v) {
+        for (int i = 0; i < 4; i++) {
+            h ^= uint8_t(uint32_t(v) >> (8 * i));
+            h *= 1099511628211ULL;
+        }
+    };
+    for (size_t i = core.tiles.hotFirst(); i < core.tiles.size(); i++) {
+        h = towerHashTile(h, core.tiles[i]);
+    }
+    mix(core.score);
+    return h;
+}
+
+
+bool saveReplay(const char* path, const Replay& replay) {
+    vector<uint8_t> out;
+    out.reserve(REPLAY_HEADER_SIZE + replay.drops.size() * 4);
+    putU32(out, REPLAY_MAGIC);
+    putU16(out, REPLAY_VERSION);
+    putU16(out, uint16_t(replay.tickHz));
+    putU64(out, replay.seed);
+    putU32(out, uint32_t(replay.drops.size()));
+    putU32(out, uint32_t(replay.finalScore));
+    putU32(out, replay.tileCount);
+    putU64(out, replay.towerHash);
+
+    uint64_t lastTick = 0;
+    for (const ReplayDrop& d : replay.drops) {
+        putVarint(out, d.tick - lastTick);
+        putU16(out, d.fraction);
+        lastTick = d.tick;
+    }
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(out.data(), 1, out.size(), f) == out.size();
+    return fclose(f) == 0 && ok;
+}
+
+bool loadReplay(const char* path, Replay& replay, const char** error) {
+    const char* unused;
+    if (!error) error = &unused;
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        *error = "cannot open file";
+        return false;
+    }
+    vector<uint8_t> data;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) data.insert(data.end(), buf, buf + n);
+    fclose(f);
+
+    *error = "corrupt replay";
+    ByteReader r{data.data(), data.data() + data.size()};
+    uint32_t magic, dropCount, score;
+    uint16_t version, tickHz;
+    if (!r.u32(magic) || magic != REPLAY_MAGIC) {
+        *error = "not a replay file";
+        return false;
+    }
+    if (!r.u16(version)) return false;
+    // Bản 1 ghi bằng mô phỏng double, mô phỏng Q16 không tái hiện được từng bit
+    if (version != REPLAY_VERSION) {
+        *error = "unsupported replay version";
+        return false;
+    }
+    if (!r.u16(tickHz)) return false;
+    if (tickHz != TOWER_TICK_HZ) {
+        *error = "unsupported tick rate";
+        return false;
+    }
+    if (!r.u64(replay.seed) || !r.u32(dropCount) || !r.u32(score) ||
+        !r.u32(replay.tileCount) || !r.u64(replay.towerHash)) {
+        return false;
+    }
+    replay.tickHz = tickHz;
+    replay.finalScore = int(score);
+
+    // Mỗi lần thả ít nhất 3 byte: chặn file hỏng khai báo số lượng quá lớn
+    if (dropCount > size_t(r.end - r.p) / 3) return false;
+    replay.drops.clear();
+    replay.drops.reserve(dropCount);
+    uint64_t tick = 0;
+    for (uint32_t i = 0; i < dropCount; i++) {
+        uint64_t delta;
+        uint16_t fraction;
+        if (!r.varint(delta) || !r.u16(fraction)) return false;
+        if (delta > REPLAY_MAX_GAP_TICKS || tick + delta > REPLAY_MAX_TICKS) {
+            *error = "drop time out of bounds";
+            return false;
+        }
+        tick += delta;
+        replay.drops.push_back({tick, fraction});
+    }
+    if (r.p != r.end) return false;
+    *error = nullptr;
+    return true;
+}
+
+
+ReplayResult runReplay(const Replay& replay, TowerEvents* events) {
+    Pcg32 rng(replay.seed);
+    TowerCore core;
+    towerReset(core, &rng, events, replay.tickHz);
+
+    for (const ReplayDrop& d : replay.drops) {
+        if (core.gameOver) break;
+        // Replay dựng tay (không qua loadReplay) cũng không được chạy vô hạn
+        if (d.tick < core.tick || d.tick - core.tick > REPLAY_MAX_GAP_TICKS || d.tick > REPLAY_MAX_TICKS) break;
+        while (core.tick < d.tick) towerTick(core);
+        towerPlaceTileFixed(core, d.fraction);
+    }
+
+    ReplayResult result;
+    result.score = core.score;
+    result.tileCount = uint32_t(core.tiles.size());
+    result.towerHash = towerHash(core);
+    result.ticks = core.tick;
+    result.gameOver = core.gameOver;
+    return result;
+}
+
+bool replayMatches(const Replay& replay, const ReplayResult& result) {
+    return result.score == replay.finalScore &&
+           result.tileCount == replay.tileCount &&
+           result.towerHash == replay.towerHash;
+}
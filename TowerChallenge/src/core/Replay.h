@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "TowerCore.h"
+
+// Replay = hạt giống + thời điểm các lần thả (tick + phần lẻ 1/65536 tick).
+// Chạy lại với cùng luật và cùng hạt giống cho ra đúng tháp và điểm số.
+// File nhị phân: header cố định rồi tới các lần thả, khoảng cách tick ghi
+// dạng varint nên mỗi lần thả thường chỉ tốn 3-4 byte.
+
+const uint32_t REPLAY_MAGIC = 0x50524354;   // "TCRP"
+const uint16_t REPLAY_VERSION = 2;          // 2: mô phỏng số nguyên (Q16)
+const int REPLAY_FRACTION_ONE = TOWER_FP_ONE;
+// Giới hạn khi đọc file không tin cậy (verify_replays): khoảng chờ giữa hai
+// lần thả và tổng thời gian ván, tính theo tick ở TOWER_TICK_HZ
+const uint64_t REPLAY_MAX_GAP_TICKS = uint64_t(10) * 60 * TOWER_TICK_HZ;     // 10 phút
+const uint64_t REPLAY_MAX_TICKS = uint64_t(24) * 3600 * TOWER_TICK_HZ;       // 24 giờ
+
+struct ReplayDrop {
+    uint64_t tick;
+    uint16_t fraction;   // phần lẻ của tick, đơn vị 1/65536
+};
+
+struct Replay {
+    uint64_t seed = 0;
+    int tickHz = TOWER_TICK_HZ;
+    std::vector<ReplayDrop> drops;
+    // Kết quả ghi lại lúc chơi, dùng để đối chiếu khi chạy lại
+    int finalScore = 0;
+    uint32_t tileCount = 0;
+    uint64_t towerHash = 0;
+};
+
+struct ReplayResult {
+    int score = 0;
+    uint32_t tileCount = 0;
+    uint64_t towerHash = 0;
+    uint64_t ticks = 0;
+    bool gameOver = false;
+};
+
+void beginReplay(Replay& replay, uint64_t seed, int tickHz);
+
+// Lượng tử hoá thời điểm thả, ghi vào replay rồi thả tile trong core.
+bool replayRecordDrop(Replay& replay, TowerCore& core, double tickFraction);
+
+// Ghi kết quả cuối ván vào replay.
+void finishReplay(Replay& replay, const TowerCore& core);
+
+// Băm toàn bộ tháp (x, y, w, màu, tốc độ của từng tile) để so khớp từng bit.
+uint64_t towerHash(const TowerCore& core);
+
+bool saveReplay(const char* path, const Replay& replay);
+// Chỉ nhận đúng REPLAY_VERSION, tickHz = TOWER_TICK_HZ và các lần thả trong
+// giới hạn ở trên. Lỗi: *error (nếu có) trỏ tới chuỗi hằng mô tả lý do.
+bool loadReplay(const char* path, Replay& replay, const char** error = nullptr);
+
+// Chạy lại replay trên một core mới, không cần SDL. Dừng (kết quả không
+// khớp) nếu một lần thả vượt các giới hạn ở trên.
+ReplayResult runReplay(const Replay& replay, TowerEvents* events = nullptr);
+bool replayMatches(const Replay& replay, const ReplayResult& result);
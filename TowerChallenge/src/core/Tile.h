@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+struct Tile {
+    int x;
+    int64_t y;           // toạ độ thế giới, giảm 40px mỗi tầng nên cần 64 bit
+    int w, h;
+    int speed;           // px/s dạng Q8 (TOWER_SPEED_SHIFT)
+    bool movingRight;
+    int colorIndex;      // chỉ số màu trong bảng màu của frontend
+    // Trạng thái chuyển động, số nguyên Q16 (TOWER_FP_SHIFT) để mọi máy chạy ra cùng kết quả
+    int32_t posX = 0;        // vị trí mô phỏng của tile đang chạy
+    int32_t prevX = 0;       // vị trí ở tick trước, để frontend nội suy khi vẽ
+    int32_t phase = 0;       // vị trí trên trục "duỗi" chu kỳ 2 * (TOWER_WIDTH - w)
+    uint32_t phaseRem = 0;   // phần dư của phép chia cho tickHz, cộng dồn qua các tick
+};
@@ -0,0 +1,195 @@
+#include "TowerCore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+using namespace std;
+
+
+// Biên độ chuyển động (Q16): tile chạy trong [0, range], chu kỳ 2 * range
+static int32_t tileRange(const Tile& t) {
+    return (TOWER_WIDTH - t.w) << TOWER_FP_SHIFT;
+}
+
+// Đặt trạng thái chuyển động từ x (px) và hướng hiện tại của tile
+static void setTilePosition(Tile& t, int x) {
+    int32_t range = tileRange(t);
+    t.posX = t.prevX = x << TOWER_FP_SHIFT;
+    t.phaseRem = 0;
+    if (range <= 0) {
+        t.phase = 0;
+        return;
+    }
+    int32_t period = 2 * range;
+    t.phase = t.movingRight ? t.posX : (period - t.posX) % period;
+}
+
+static Tile makeMovingTile(TowerCore& core, int64_t y, int w, int speed) {
+    Tile t;
+    t.x = 0;
+    t.y = y;
+    t.w = w;
+    t.h = TILE_HEIGHT;
+    t.speed = speed;
+    t.movingRight = (core.rng->next() % 2 == 0);
+    t.colorIndex = int(core.rng->next() % TOWER_PALETTE_SIZE);
+    setTilePosition(t, t.x);
+    return t;
+}
+
+
+void towerReset(TowerCore& core, TowerRng* rng, TowerEvents* events, int tickHz) {
+    towerStoreClear(core.tiles);
+    core.score = 0;
+    core.gameOver = false;
+    core.tickHz = tickHz;
+    core.tick = 0;
+    core.rng = rng;
+    core.events = events;
+
+    Tile base;
+    base.x = (TOWER_WIDTH - INITIAL_TILE_WIDTH) / 2;
+    base.y = TOWER_BASE_Y;
+    base.w = INITIAL_TILE_WIDTH;
+    base.h = TILE_HEIGHT;
+    base.speed = 0;   // Thanh mốc đứng im
+    base.movingRight = false;
+    base.colorIndex = int(rng->next() % TOWER_PALETTE_SIZE);
+    setTilePosition(base, base.x);
+    towerStorePush(core.tiles, base);
+
+    Tile first;
+    first.x = 0;
+    first.y = TOWER_BASE_Y - TILE_HEIGHT;
+    first.w = INITIAL_TILE_WIDTH;
+    first.h = TILE_HEIGHT;
+    first.speed = core.rules.initialSpeed;
+    first.movingRight = true;
+    first.colorIndex = int(rng->next() % TOWER_PALETTE_SIZE);
+    setTilePosition(first, first.x);
+    towerStorePush(core.tiles, first);
+}
+
+
+int32_t towerTileXAfter(const Tile& t, int tickHz, uint32_t fraction, bool* movingRight) {
+    int32_t range = tileRange(t);
+    if (range <= 0) {
+        if (movingRight) *movingRight = true;
+        return 0;
+    }
+
+    // Quãng đường (Q16) = speed * thời gian; tốc độ Q8 -> Q16 là dịch 8 bit
+    int64_t period = 2 * int64_t(range);
+    uint64_t speed = uint64_t(t.speed) << (TOWER_FP_SHIFT - TOWER_SPEED_SHIFT);
+    uint64_t travel = (t.phaseRem + ((speed * fraction) >> TOWER_FP_SHIFT)) / uint64_t(tickHz);
+    int64_t u = (t.phase + int64_t(travel % uint64_t(period))) % period;
+
+    if (movingRight) *movingRight = u < range;
+    return int32_t(u <= range ? u : period - u);
+}
+
+
+void towerTick(TowerCore& core) {
+    if (core.gameOver || core.tiles.size() < 2) return;
+    Tile& t = core.tiles.back();
+    t.prevX = t.posX;
+    core.tick++;
+
+    int32_t range = tileRange(t);
+    if (range <= 0) {
+        t.posX = 0;
+        t.movingRight = true;
+        return;
+    }
+    int32_t period = 2 * range;
+    uint32_t acc = t.phaseRem + (uint32_t(t.speed) << (TOWER_FP_SHIFT - TOWER_SPEED_SHIFT));
+    t.phase += int32_t(acc / uint32_t(core.tickHz));
+    t.phaseRem = acc % uint32_t(core.tickHz);
+    while (t.phase >= period) t.phase -= period;
+
+    t.movingRight = t.phase < range;
+    t.posX = t.movingRight ? t.phase : period - t.phase;
+}
+
+void towerAdvance(TowerCore& core, uint64_t ticks) {
+    if (ticks == 0 || core.gameOver || core.tiles.size() < 2) return;
+    Tile& t = core.tiles.back();
+    int32_t range = tileRange(t);
+    if (ticks > 1) {
+        // Tới tick áp chót bằng một phép chia, tick cuối qua towerTick để có prevX
+        if (range > 0) {
+            int64_t period = 2 * int64_t(range);
+            uint64_t acc = t.phaseRem + (ticks - 1) * (uint64_t(t.speed) << (TOWER_FP_SHIFT - TOWER_SPEED_SHIFT));
+            t.phase = int32_t((t.phase + int64_t(acc / uint64_t(core.tickHz) % uint64_t(period))) % period);
+            t.phaseRem = uint32_t(acc % uint64_t(core.tickHz));
+            t.movingRight = t.phase < range;
+            t.posX = t.movingRight ? t.phase : int32_t(period) - t.phase;
+        } else {
+            t.posX = 0;
+            t.movingRight = true;
+        }
+        core.tick += ticks - 1;
+    }
+    towerTick(core);
+}
+
+
+TowerDropResult towerResolveDrop(int prevX, int prevW, int x, int w, int* outX, int* outW, int tolerance) {
+    int L = max(x, prevX);
+    int R = min(x + w, prevX + prevW);
+    int W = R - L;
+    if (W <= 0) return TOWER_DROP_MISS;
+
+    if (abs(x - prevX) < tolerance && W >= prevW - tolerance) {
+        *outX = prevX;
+        *outW = prevW;
+        return TOWER_DROP_PERFECT;
+    }
+    *outX = L;
+    *outW = W;
+    return TOWER_DROP_PLACED;
+}
+
+
+bool towerPlaceTile(TowerCore& core, double tickFraction) {
+    long q = lround(tickFraction * TOWER_FP_ONE);
+    if (q < 0) q = 0;
+    if (q >= TOWER_FP_ONE) q = TOWER_FP_ONE - 1;
+    return towerPlaceTileFixed(core, uint32_t(q));
+}
+
+bool towerPlaceTileFixed(TowerCore& core, uint32_t fraction) {
+    if (core.gameOver || core.tiles.size() < 2) return false;
+
+    Tile& curr = core.tiles.back();
+    const Tile& prev = core.tiles[core.tiles.size() - 2];
+    int32_t xq = towerTileXAfter(curr, core.tickHz, fraction, nullptr);
+    curr.x = (xq + TOWER_FP_ONE / 2) >> TOWER_FP_SHIFT;
+
+    const TowerRules& rules = core.rules;
+    TowerDropResult result = towerResolveDrop(prev.x, prev.w, curr.x, curr.w, &curr.x, &curr.w,
+                                              rules.perfectTolerance);
+    if (result == TOWER_DROP_MISS) {
+        core.gameOver = true;
+        if (core.events) core.events->onGameOver(core);
+        return false;
+    }
+
+    bool isPerfect = result == TOWER_DROP_PERFECT;
+    if (isPerfect) {
+        core.score += PERFECT_BONUS;
+    } else {
+        core.score += 1;
+        curr.speed = min(rules.maxSpeed, curr.speed + rules.speedIncrement);
+    }
+    curr.y = prev.y - TILE_HEIGHT;
+    setTilePosition(curr, curr.x);
+
+    if (core.events) core.events->onTilePlaced(core, curr, isPerfect);
+
+    // Thêm thanh di chuyển tiếp theo
+    Tile next = makeMovingTile(core, curr.y - TILE_HEIGHT, curr.w, curr.speed);
+    towerStorePush(core.tiles, next);
+    return true;
+}
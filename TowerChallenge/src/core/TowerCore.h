@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Tile.h"
+#include "TowerStore.h"
+
+// tower_core: luật chơi thuần tuý, không phụ thuộc SDL. Thời gian là số tick
+// do bên gọi đưa vào (đồng hồ ảo), số ngẫu nhiên và âm thanh/hiệu ứng đi qua
+// các interface được tiêm vào, nên có thể chạy headless với tốc độ tối đa
+// cho bot, replay, benchmark.
+//
+// Toàn bộ mô phỏng là số nguyên: vị trí Q16 px, tốc độ Q8 px/s, thời điểm
+// thả là tick + phần lẻ Q16. Mỗi tick tile tiến (speed << 8) / tickHz đơn vị
+// Q16, phần dư được cộng dồn nên không trôi; cùng hạt giống và cùng input
+// cho ra đúng từng bit trên mọi compiler và mức tối ưu.
+
+const int TOWER_WIDTH = 450;          // bề rộng vùng chơi (= bề rộng cửa sổ)
+const int TILE_HEIGHT = 40;
+const int TOWER_BASE_Y = 600 - TILE_HEIGHT;   // thanh mốc nằm sát đáy cửa sổ 600px
+const int INITIAL_TILE_WIDTH = 200;
+const int TOWER_FP_SHIFT = 16;
+const int TOWER_FP_ONE = 1 << TOWER_FP_SHIFT;
+const int TOWER_SPEED_SHIFT = 8;
+const int INITIAL_SPEED = 200 << TOWER_SPEED_SHIFT;
+const int MAX_SPEED = 200 << TOWER_SPEED_SHIFT;
+const int SPEED_INCREMENT = 1 << TOWER_SPEED_SHIFT;   // 1 px/s: bản gốc ghi 1.25 vào int nên luật thật là 1
+const int PERFECT_TOLERANCE = 2;
+const int PERFECT_BONUS = 5;
+const int TOWER_PALETTE_SIZE = 5;
+const int TOWER_TICK_HZ = 240;
+const size_t TOWER_TILE_RESERVE = 4096;   // cấp phát trước cho replay, tránh vector giãn giữa ván
+
+
+// Các thông số độ khó; mặc định là luật của game (replay luôn dùng mặc định).
+// tools/difficulty_sweep thử các bộ khác để cân chỉnh.
+struct TowerRules {
+    int initialSpeed = INITIAL_SPEED;     // Q8 px/s
+    int maxSpeed = MAX_SPEED;
+    int speedIncrement = SPEED_INCREMENT; // cộng sau mỗi lần thả không perfect
+    int perfectTolerance = PERFECT_TOLERANCE;
+};
+
+
+struct TowerRng {
+    virtual ~TowerRng() {}
+    virtual uint32_t next() = 0;
+};
+
+struct TowerCore;
+
+struct TowerEvents {
+    virtual ~TowerEvents() {}
+    virtual void onTilePlaced(const TowerCore& /*core*/, const Tile& /*tile*/, bool /*perfect*/) {}
+    virtual void onGameOver(const TowerCore& /*core*/) {}
+};
+
+struct TowerCore {
+    TowerStore tiles;   // tiles[0] là thanh mốc, tiles.back() là tile đang chạy
+    int score = 0;
+    bool gameOver = false;
+    int tickHz = TOWER_TICK_HZ;
+    uint64_t tick = 0;
+    TowerRng* rng = nullptr;
+    TowerEvents* events = nullptr;
+    TowerRules rules;   // giữ qua các ván, towerReset không đổi
+};
+
+// Bắt đầu ván mới: thanh mốc đứng im + tile đầu tiên chạy từ mép trái.
+void towerReset(TowerCore& core, TowerRng* rng, TowerEvents* events, int tickHz = TOWER_TICK_HZ);
+
+// Tiến mô phỏng thêm một tick (1 / tickHz giây).
+void towerTick(TowerCore& core);
+// Như gọi towerTick ticks lần (kết quả giống từng bit), tính trực tiếp.
+void towerAdvance(TowerCore& core, uint64_t ticks);
+
+// Thả tile đang chạy tại thời điểm tick + fraction / TOWER_FP_ONE.
+// Trả về false nếu trượt hoàn toàn (game over).
+bool towerPlaceTileFixed(TowerCore& core, uint32_t fraction);
+// Như trên, tickFraction (0 <= tickFraction < 1) được lượng tử hoá về Q16.
+bool towerPlaceTile(TowerCore& core, double tickFraction);
+
+enum TowerDropResult { TOWER_DROP_MISS, TOWER_DROP_PLACED, TOWER_DROP_PERFECT };
+
+// Luật đặt tile: tile rộng w thả tại x lên tile (prevX, prevW). Ghi vị trí
+// và bề rộng sau khi cắt (hoặc khớp hẳn nếu perfect) vào outX, outW.
+TowerDropResult towerResolveDrop(int prevX, int prevW, int x, int w, int* outX, int* outW,
+                                 int tolerance = PERFECT_TOLERANCE);
+
+// Vị trí (Q16) của tile đang chạy sau thêm fraction / TOWER_FP_ONE tick, nảy
+// lại ở hai mép. fraction có thể lớn hơn một tick.
+int32_t towerTileXAfter(const Tile& t, int tickHz, uint32_t fraction, bool* movingRight);
@@ -0,0 +1,220 @@
+#include "TowerStore.h"
+
+#include "TowerCore.h"
+
+using namespace std;
+
+// Mỗi tile tối đa: dx, dw dạng zigzag varint (3 byte) + 1 byte màu
+const size_t PACKED_TILE_MAX_BYTES = 3 + 3 + 1;
+
+
+static void putVarint(vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(uint8_t(v) | 0x80);
+        v >>= 7;
+    }
+    out.push_back(uint8_t(v));
+}
+
+static bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p >= end) return false;
+        uint8_t b = *p++;
+        v |= uint64_t(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static uint64_t zigzag(int32_t v) { return (uint64_t(uint32_t(v)) << 1) ^ uint64_t(int64_t(v >> 31)); }
+static int32_t unzigzag(uint64_t v) { return int32_t(uint32_t(v >> 1) ^ uint32_t(-int64_t(v & 1))); }
+
+
+uint64_t towerHashTile(uint64_t h, const Tile& t) {
+    // y chỉ lấy 32 bit thấp như khi còn là int, để hash của replay cũ vẫn khớp
+    // tốc độ băm theo px/s nguyên như trước khi chuyển sang Q8
+    const int32_t fields[5] = {t.x, int32_t(t.y), t.w, t.colorIndex, t.speed >> TOWER_SPEED_SHIFT};
+    for (int32_t v : fields) {
+        for (int i = 0; i < 4; i++) {
+            h ^= uint8_t(uint32_t(v) >> (8 * i));
+            h *= 1099511628211ULL;
+        }
+    }
+    return h;
+}
+
+
+// Khối: varint số tile, varint số byte, rồi từng tile (dx, dw, màu) so với
+// tile trước trong cùng khối, nên các khối giải mã độc lập với nhau.
+static void encodeBlock(const vector<PackedTile>& block, vector<uint8_t>& out) {
+    int32_t prevX = 0, prevW = 0;
+    for (const PackedTile& p : block) {
+        putVarint(out, zigzag(p.x - prevX));
+        putVarint(out, zigzag(p.w - prevW));
+        out.push_back(p.colorIndex);
+        prevX = p.x;
+        prevW = p.w;
+    }
+}
+
+static void flushBlock(TowerStore& store) {
+    if (store.block.empty()) return;
+    store.scratch.clear();
+    encodeBlock(store.block, store.scratch);
+
+    uint8_t header[20];
+    size_t headerLen = 0;
+    for (uint64_t v : {uint64_t(store.block.size()), uint64_t(store.scratch.size())}) {
+        while (v >= 0x80) {
+            header[headerLen++] = uint8_t(v) | 0x80;
+            v >>= 7;
+        }
+        header[headerLen++] = uint8_t(v);
+    }
+
+    if (store.spill) {
+        bool ok = fwrite(header, 1, headerLen, store.spill) == headerLen &&
+                  fwrite(store.scratch.data(), 1, store.scratch.size(), store.spill) == store.scratch.size();
+        if (ok) {
+            store.spilledTiles += store.block.size();
+            store.spilledBytes += headerLen + store.scratch.size();
+            store.block.clear();
+            return;
+        }
+        // Ghi lỗi (đầy đĩa...): bỏ spill, từ đây giữ các khối mới nhất trong bộ nhớ
+        fclose(store.spill);
+        store.spill = nullptr;
+        store.spillError = "write failed";
+        store.droppedTiles = store.spilledTiles;   // phần đã ghi của ván này không đọc lại được nữa
+    }
+    // Quá số khối cho phép: bỏ khối cũ nhất, dùng lại bộ nhớ của nó cho khối mới
+    vector<uint8_t> out;
+    if (store.encoded.size() >= TOWER_HISTORY_MAX_BLOCKS) {
+        out.swap(store.encoded.front());
+        store.encoded.pop_front();
+        store.droppedTiles += TOWER_HISTORY_BLOCK;
+        out.clear();
+    }
+    out.insert(out.end(), header, header + headerLen);
+    out.insert(out.end(), store.scratch.begin(), store.scratch.end());
+    store.encoded.push_back(std::move(out));
+    store.block.clear();
+}
+
+
+void towerStoreClear(TowerStore& store) {
+    store.count = 0;
+    store.historyHash = TOWER_HASH_BASIS;
+    store.block.clear();
+    store.block.reserve(TOWER_HISTORY_BLOCK);
+    store.encoded.clear();
+    store.droppedTiles = 0;
+    store.scratch.reserve(TOWER_HISTORY_BLOCK * PACKED_TILE_MAX_BYTES);
+    store.spilledTiles = store.spilledBytes = 0;
+
+    if (store.spillPath && !store.spillOpened) {
+        store.spillOpened = true;
+        store.spill = fopen(store.spillPath, "w+b");
+        uint8_t header[6] = {uint8_t(TOWER_SPILL_MAGIC), uint8_t(TOWER_SPILL_MAGIC >> 8),
+                             uint8_t(TOWER_SPILL_MAGIC >> 16), uint8_t(TOWER_SPILL_MAGIC >> 24),
+                             uint8_t(TOWER_SPILL_VERSION), uint8_t(TOWER_SPILL_VERSION >> 8)};
+        if (!store.spill) {
+            store.spillError = "cannot open file";
+        } else if (fwrite(header, 1, sizeof(header), store.spill) != sizeof(header)) {
+            towerStoreClose(store);
+            store.spillError = "write failed";
+        }
+    }
+    // Dấu đầu ván: các ván trước vẫn nằm nguyên phía trước trong file
+    if (store.spill) {
+        store.spillGameStart = ftell(store.spill) + 1;
+        if (fputc(0, store.spill) == EOF) {
+            towerStoreClose(store);
+            store.spillError = "write failed";
+        }
+    }
+}
+
+void towerStoreClose(TowerStore& store) {
+    if (store.spill) fclose(store.spill);
+    store.spill = nullptr;
+}
+
+void towerStorePush(TowerStore& store, const Tile& tile) {
+    if (store.count >= TOWER_HOT_TILES) {
+        // Tile sắp bị ghi đè đã đứng yên từ lâu: gộp vào hash rồi nén
+        const Tile& old = store[store.count - TOWER_HOT_TILES];
+        store.historyHash = towerHashTile(store.historyHash, old);
+        store.block.push_back({int16_t(old.x), uint16_t(old.w), uint8_t(old.colorIndex)});
+        if (store.block.size() >= TOWER_HISTORY_BLOCK) flushBlock(store);
+    }
+    store[store.count] = tile;
+    store.count++;
+}
+
+
+// first: chỉ số (trong tháp) của out[0], để suy ra y
+static bool decodeBlocks(const uint8_t* p, const uint8_t* end, size_t first, vector<Tile>& out) {
+    while (p < end) {
+        uint64_t tiles, bytes;
+        if (!getVarint(p, end, tiles) || !getVarint(p, end, bytes)) return false;
+        if (bytes > uint64_t(end - p)) return false;
+        const uint8_t* blockEnd = p + bytes;
+        int32_t x = 0, w = 0;
+        for (uint64_t i = 0; i < tiles; i++) {
+            uint64_t dx, dw;
+            if (!getVarint(p, blockEnd, dx) || !getVarint(p, blockEnd, dw) || p >= blockEnd) return false;
+            x += unzigzag(dx);
+            w += unzigzag(dw);
+            Tile t = {};
+            t.x = x;
+            t.w = w;
+            t.h = TILE_HEIGHT;
+            t.y = TOWER_BASE_Y - int64_t(first + out.size()) * TILE_HEIGHT;
+            t.colorIndex = *p++;
+            t.posX = t.prevX = x << TOWER_FP_SHIFT;
+            out.push_back(t);
+        }
+        if (p != blockEnd) return false;
+    }
+    return true;
+}
+
+bool towerStoreHistory(TowerStore& store, vector<Tile>& out) {
+    out.clear();
+    out.reserve(store.count - store.droppedTiles);
+    size_t first = store.droppedTiles;
+
+    if (store.spill) {
+        fflush(store.spill);
+        long size = ftell(store.spill);
+        long start = store.spillGameStart;
+        vector<uint8_t> data(size > start ? size_t(size - start) : 0);
+        bool ok = size >= start && fseek(store.spill, start, SEEK_SET) == 0 &&
+                  fread(data.data(), 1, data.size(), store.spill) == data.size();
+        fseek(store.spill, 0, SEEK_END);
+        if (!ok || !decodeBlocks(data.data(), data.data() + data.size(), first, out)) return false;
+    }
+    for (const vector<uint8_t>& b : store.encoded) {
+        if (!decodeBlocks(b.data(), b.data() + b.size(), first, out)) return false;
+    }
+    for (const PackedTile& p : store.block) {
+        Tile t = {};
+        t.x = p.x;
+        t.w = p.w;
+        t.h = TILE_HEIGHT;
+        t.y = TOWER_BASE_Y - int64_t(first + out.size()) * TILE_HEIGHT;
+        t.colorIndex = p.colorIndex;
+        t.posX = t.prevX = p.x << TOWER_FP_SHIFT;
+        out.push_back(t);
+    }
+    for (size_t i = store.hotFirst(); i < store.count; i++) out.push_back(store[i]);
+    return first + out.size() == store.count;
+}
+
+size_t towerStoreHistoryBytes(const TowerStore& store) {
+    size_t bytes = store.block.capacity() * sizeof(PackedTile) + store.scratch.capacity();
+    for (const vector<uint8_t>& b : store.encoded) bytes += b.capacity();
+    return bytes;
+}
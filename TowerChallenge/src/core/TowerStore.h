@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+#include "Tile.h"
+
+// Kho tile của tháp với bộ nhớ cố định. Chỉ TOWER_HOT_TILES tile mới nhất
+// được giữ nguyên dạng Tile trong một ring buffer (mô phỏng chỉ cần hai tile
+// trên cùng, phần vẽ chỉ cần vài dải quanh camera). Tile rơi khỏi cửa sổ
+// được nén thành PackedTile (x, w, màu; y suy ra từ chỉ số), gom thành khối
+// TOWER_HISTORY_BLOCK tile rồi mã hoá delta + varint. Khối đã mã hoá được
+// ghi nối vào file spill nếu có (game luôn có, xem --tower-log), nên lịch sử
+// đầy đủ của mọi ván vẫn lấy lại được. Không có spill (công cụ headless) hoặc
+// ghi lỗi thì chỉ giữ TOWER_HISTORY_MAX_BLOCKS khối mới nhất trong bộ nhớ
+// (~3 byte/tile), khối cũ hơn bị bỏ (droppedTiles). Hash vẫn phủ mọi tile vì
+// được gộp lúc đẩy vào. towerStoreHistory dựng lại tháp từ historyFirst().
+//
+// File spill: "TCSP" + version (u16), rồi mỗi ván một byte 0 đánh dấu đầu
+// ván và các khối của ván đó (varint số tile > 0, varint số byte, dữ liệu).
+// File mở (ghi đè) một lần ở ván đầu, các ván sau ghi nối tiếp.
+
+const size_t TOWER_HOT_TILES = 256;        // lũy thừa của 2
+const size_t TOWER_HISTORY_BLOCK = 4096;
+const size_t TOWER_HISTORY_MAX_BLOCKS = 64;   // ~262k tile, tối đa ~1.8 MB
+const uint32_t TOWER_SPILL_MAGIC = 0x50534354;   // "TCSP"
+const uint16_t TOWER_SPILL_VERSION = 2;   // 2: nhiều ván một file
+
+struct PackedTile {
+    int16_t x;
+    uint16_t w;
+    uint8_t colorIndex;
+};
+
+struct TowerStore {
+    Tile hot[TOWER_HOT_TILES];
+    size_t count = 0;                    // tổng số tile từ đầu ván
+    uint64_t historyHash = 0;            // FNV-1a đã gộp các tile rời cửa sổ
+    std::vector<PackedTile> block;       // khối đang gom, chưa mã hoá
+    std::deque<std::vector<uint8_t>> encoded;   // khối đã mã hoá (header + dữ liệu) khi không spill
+    std::vector<uint8_t> scratch;        // bộ đệm mã hoá một khối
+    const char* spillPath = nullptr;     // giữ qua các ván, nullptr = không spill
+    FILE* spill = nullptr;               // mở suốt chương trình, đóng ở towerStoreClose
+    bool spillOpened = false;            // đã thử mở spillPath (chỉ ghi đè một lần)
+    long spillGameStart = 0;             // vị trí khối đầu của ván hiện tại trong file
+    const char* spillError = nullptr;    // lỗi spill chưa báo; frontend log rồi đặt lại nullptr
+    size_t spilledTiles = 0;
+    size_t spilledBytes = 0;
+    size_t droppedTiles = 0;             // tile cũ nhất đã bỏ khỏi bộ nhớ (không spill)
+
+    TowerStore() {}
+    // Giữ FILE* spill: sao chép sẽ dùng chung và đóng hai lần
+    TowerStore(const TowerStore&) = delete;
+    TowerStore& operator=(const TowerStore&) = delete;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    // Chỉ số tile cũ nhất còn trong cửa sổ nóng; operator[] chỉ hợp lệ từ đây.
+    size_t hotFirst() const { return count > TOWER_HOT_TILES ? count - TOWER_HOT_TILES : 0; }
+    // Chỉ số tile cũ nhất towerStoreHistory còn dựng lại được.
+    size_t historyFirst() const { return droppedTiles; }
+    Tile& operator[](size_t i) { return hot[i & (TOWER_HOT_TILES - 1)]; }
+    const Tile& operator[](size_t i) const { return hot[i & (TOWER_HOT_TILES - 1)]; }
+    Tile& back() { return (*this)[count - 1]; }
+    const Tile& back() const { return (*this)[count - 1]; }
+};
+
+// Xoá tháp cho ván mới; nếu có spillPath thì ghi dấu ván mới vào file spill
+// (mở và ghi đè ở lần gọi đầu).
+void towerStoreClear(TowerStore& store);
+void towerStorePush(TowerStore& store, const Tile& tile);
+// Đóng file spill (cuối chương trình).
+void towerStoreClose(TowerStore& store);
+
+// FNV-1a của một tile, dùng chung cho historyHash và towerHash.
+uint64_t towerHashTile(uint64_t h, const Tile& t);
+const uint64_t TOWER_HASH_BASIS = 14695981039346656037ULL;
+
+// Dựng lại tháp từ tile historyFirst() (thanh mốc nếu chưa bỏ khối nào) tới
+// tile trên cùng. Tile đã nén chỉ còn x, y, w, h, colorIndex; tile trong cửa
+// sổ nóng được chép nguyên.
+bool towerStoreHistory(TowerStore& store, std::vector<Tile>& out);
+
+// Bộ nhớ đang dùng cho lịch sử (không tính cửa sổ nóng cố định).
+size_t towerStoreHistoryBytes(const TowerStore& store);
@@ -0,0 +1,291 @@
+#include "VecEnv.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define VEC_ENV_SSE2 1
+#endif
+
+using namespace std;
+
+
+static void setSpeed(VecEnv& env, size_t i, int speed) {
+    uint32_t s = uint32_t(speed) << (TOWER_FP_SHIFT - TOWER_SPEED_SHIFT);
+    env.speed[i] = speed;
+    env.stepQ[i] = int32_t(s / uint32_t(env.tickHz));
+    env.stepR[i] = int32_t(s % uint32_t(env.tickHz));
+}
+
+// Tile mới có bề rộng w luôn xuất phát ở x = 0, pha 0
+static void spawnTile(VecEnv& env, size_t i, int w, int speed) {
+    env.width[i] = w;
+    env.range[i] = (TOWER_WIDTH - w) << TOWER_FP_SHIFT;
+    env.period[i] = 2 * env.range[i];
+    env.phase[i] = 0;
+    env.phaseRem[i] = 0;
+    setSpeed(env, i, speed);
+}
+
+static void tickOne(VecEnv& env, size_t i) {
+    env.phaseRem[i] += env.stepR[i];
+    env.phase[i] += env.stepQ[i];
+    if (env.phaseRem[i] > env.hzMinusOne) {
+        env.phaseRem[i] -= env.tickHz;
+        env.phase[i]++;
+    }
+    if (env.phase[i] >= env.period[i]) env.phase[i] -= env.period[i];
+}
+
+// Như towerReset, rồi chờ ngẫu nhiên trong một chu kỳ chuyển động
+static void resetOne(VecEnv& env, size_t i) {
+    env.prevX[i] = (TOWER_WIDTH - INITIAL_TILE_WIDTH) / 2;
+    env.prevW[i] = INITIAL_TILE_WIDTH;
+    env.score[i] = 0;
+    env.tiles[i] = 2;
+    int speed = env.rules.initialSpeed;
+    spawnTile(env, i, INITIAL_TILE_WIDTH, speed);
+
+    uint32_t periodTicks = uint32_t(int64_t(env.period[i]) * env.tickHz /
+                                    (int64_t(speed) << (TOWER_FP_SHIFT - TOWER_SPEED_SHIFT)));
+    uint32_t wait = env.rng[i].nextU32() % (periodTicks + 1);
+    // Từ pha 0, dư 0: sau wait tick đã đi đúng wait * bước / tickHz, không cần lặp
+    int64_t travel = int64_t(wait) * (int64_t(speed) << (TOWER_FP_SHIFT - TOWER_SPEED_SHIFT));
+    env.phase[i] = int32_t(travel / env.tickHz % env.period[i]);
+    env.phaseRem[i] = int32_t(travel % env.tickHz);
+}
+
+static int32_t tileX(const VecEnv& env, size_t i) {
+    int32_t u = env.phase[i];
+    int32_t xq = u <= env.range[i] ? u : env.period[i] - u;
+    return (xq + TOWER_FP_ONE / 2) >> TOWER_FP_SHIFT;
+}
+
+// Bản vô hướng, dùng cho phần đuôi và khi không có SSE2
+static bool stepOne(VecEnv& env, size_t i, uint8_t action, float* rewards, uint8_t* dones) {
+    const TowerRules& rules = env.rules;
+    int reward = 0;
+    bool done = false;
+    if (action) {
+        int outX, outW;
+        TowerDropResult r = towerResolveDrop(env.prevX[i], env.prevW[i], tileX(env, i), env.width[i],
+                                             &outX, &outW, rules.perfectTolerance);
+        if (r == TOWER_DROP_MISS) {
+            done = true;
+        } else {
+            bool perfect = r == TOWER_DROP_PERFECT;
+            reward = perfect ? PERFECT_BONUS : 1;
+            env.score[i] += reward;
+            env.tiles[i]++;
+            env.prevX[i] = outX;
+            env.prevW[i] = outW;
+            spawnTile(env, i, outW,
+                      perfect ? env.speed[i] : min(rules.maxSpeed, env.speed[i] + rules.speedIncrement));
+        }
+    }
+    if (done) {
+        resetOne(env, i);
+    } else {
+        tickOne(env, i);
+    }
+    if (rewards) rewards[i] = float(reward);
+    if (dones) dones[i] = done;
+    return done;
+}
+
+#ifdef VEC_ENV_SSE2
+static inline __m128i load4(const vector<int32_t>& v, size_t i) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(v.data() + i));
+}
+static inline void store4(vector<int32_t>& v, size_t i, __m128i x) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(v.data() + i), x);
+}
+static inline __m128i select4(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+static inline __m128i min4(__m128i a, __m128i b) { return select4(_mm_cmplt_epi32(a, b), a, b); }
+static inline __m128i max4(__m128i a, __m128i b) { return select4(_mm_cmpgt_epi32(a, b), a, b); }
+
+// 4 ván một lượt: towerResolveDrop không rẽ nhánh rồi tick. Ván thả tile cần
+// chia lại tốc độ, ván thua cần reset: hiếm nên làm vô hướng sau đó.
+static int step4(VecEnv& env, size_t i, const uint8_t* actions, float* rewards, uint8_t* dones) {
+    const TowerRules& rules = env.rules;
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i tolerance = _mm_set1_epi32(rules.perfectTolerance);
+    uint32_t packed;
+    memcpy(&packed, actions + i, 4);
+    __m128i act = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(int(packed)), zero), zero);
+    act = _mm_cmpgt_epi32(act, zero);
+
+    __m128i phase = load4(env.phase, i);
+    __m128i range = load4(env.range, i);
+    __m128i period = load4(env.period, i);
+    __m128i w = load4(env.width, i);
+    __m128i prevX = load4(env.prevX, i);
+    __m128i prevW = load4(env.prevW, i);
+
+    __m128i xq = select4(_mm_cmpgt_epi32(phase, range), _mm_sub_epi32(period, phase), phase);
+    __m128i x = _mm_srai_epi32(_mm_add_epi32(xq, _mm_set1_epi32(TOWER_FP_ONE / 2)), TOWER_FP_SHIFT);
+    __m128i L = max4(x, prevX);
+    __m128i R = min4(_mm_add_epi32(x, w), _mm_add_epi32(prevX, prevW));
+    __m128i W = _mm_sub_epi32(R, L);
+    __m128i hit = _mm_cmpgt_epi32(W, zero);
+
+    __m128i dx = _mm_sub_epi32(x, prevX);
+    __m128i sign = _mm_srai_epi32(dx, 31);
+    __m128i adx = _mm_sub_epi32(_mm_xor_si128(dx, sign), sign);
+    __m128i perfect = _mm_and_si128(
+        _mm_cmplt_epi32(adx, tolerance),
+        _mm_cmpgt_epi32(W, _mm_sub_epi32(_mm_sub_epi32(prevW, tolerance), one)));
+
+    __m128i placed = _mm_and_si128(act, hit);
+    __m128i missed = _mm_andnot_si128(hit, act);
+    perfect = _mm_and_si128(perfect, placed);
+    __m128i reward = _mm_and_si128(placed, select4(perfect, _mm_set1_epi32(PERFECT_BONUS), one));
+
+    // Ván thả trúng: tile trên cùng mới, tile chạy mới ở pha 0
+    __m128i newX = select4(perfect, prevX, L);
+    __m128i newW = select4(perfect, prevW, W);
+    store4(env.prevX, i, select4(placed, newX, prevX));
+    store4(env.prevW, i, select4(placed, newW, prevW));
+    w = select4(placed, newW, w);
+    range = _mm_slli_epi32(_mm_sub_epi32(_mm_set1_epi32(TOWER_WIDTH), w), TOWER_FP_SHIFT);
+    period = _mm_add_epi32(range, range);
+    store4(env.width, i, w);
+    store4(env.range, i, range);
+    store4(env.period, i, period);
+    store4(env.score, i, _mm_add_epi32(load4(env.score, i), reward));
+    store4(env.tiles, i, _mm_sub_epi32(load4(env.tiles, i), placed));
+    phase = _mm_andnot_si128(placed, phase);
+    __m128i rem = _mm_andnot_si128(placed, load4(env.phaseRem, i));
+
+    int changedBits = _mm_movemask_ps(_mm_castsi128_ps(_mm_andnot_si128(perfect, placed)));
+    for (int k = 0; k < 4; k++) {
+        if (changedBits & (1 << k)) {
+            setSpeed(env, i + k, min(rules.maxSpeed, env.speed[i + k] + rules.speedIncrement));
+        }
+    }
+
+    // Tick: bước nguyên + dư đã chia sẵn, nhớ 1 khi dư tràn tickHz
+    rem = _mm_add_epi32(rem, load4(env.stepR, i));
+    phase = _mm_add_epi32(phase, load4(env.stepQ, i));
+    __m128i carry = _mm_cmpgt_epi32(rem, _mm_set1_epi32(env.hzMinusOne));
+    rem = _mm_sub_epi32(rem, _mm_and_si128(carry, _mm_set1_epi32(env.tickHz)));
+    phase = _mm_sub_epi32(phase, carry);
+    __m128i wrap = _mm_cmpgt_epi32(phase, _mm_sub_epi32(period, one));
+    phase = _mm_sub_epi32(phase, _mm_and_si128(wrap, period));
+    store4(env.phase, i, phase);
+    store4(env.phaseRem, i, rem);
+
+    int missedBits = _mm_movemask_ps(_mm_castsi128_ps(missed));
+    for (int k = 0; k < 4; k++) {
+        if (missedBits & (1 << k)) resetOne(env, i + k);
+    }
+
+    if (rewards) _mm_storeu_ps(rewards + i, _mm_cvtepi32_ps(reward));
+    if (dones) {
+        for (int k = 0; k < 4; k++) dones[i + k] = (missedBits >> k) & 1;
+    }
+    return (missedBits & 1) + ((missedBits >> 1) & 1) + ((missedBits >> 2) & 1) + (missedBits >> 3);
+}
+#endif
+
+// Trả về số ván vừa kết thúc
+static uint64_t stepRange(VecEnv& env, size_t begin, size_t end, const uint8_t* actions, float* rewards,
+                          uint8_t* dones) {
+    uint64_t ended = 0;
+    size_t i = begin;
+#ifdef VEC_ENV_SSE2
+    for (; i + 4 <= end; i += 4) ended += step4(env, i, actions, rewards, dones);
+#endif
+    for (; i < end; i++) ended += stepOne(env, i, actions[i], rewards, dones);
+    return ended;
+}
+
+
+void initVecEnv(VecEnv& env, size_t count, int threads, int tickHz, const TowerRules& rules) {
+    env.count = count;
+    env.tickHz = tickHz;
+    env.hzMinusOne = tickHz - 1;
+    env.rules = rules;
+    for (vector<int32_t>* v : {&env.phase, &env.phaseRem, &env.stepQ, &env.stepR, &env.range, &env.period,
+                               &env.width, &env.speed, &env.prevX, &env.prevW, &env.score, &env.tiles}) {
+        v->assign(count, 0);
+    }
+    env.rng.assign(count, Pcg32());
+    env.blockEnded.assign((count + VEC_ENV_BLOCK - 1) / VEC_ENV_BLOCK, 0);
+    env.pool.reset(new JobPool(threads));
+    env.steps = env.episodes = 0;
+}
+
+void vecEnvReset(VecEnv& env, uint64_t seed) {
+    for (size_t i = 0; i < env.count; i++) {
+        env.rng[i].seed(seed, i);
+        resetOne(env, i);
+    }
+    env.steps = env.episodes = 0;
+}
+
+void vecEnvStep(VecEnv& env, const uint8_t* actions, float* rewards, uint8_t* dones) {
+    size_t blocks = env.blockEnded.size();
+    // Gom tham số vào một struct: lambda chỉ giữ một con trỏ, vừa bộ đệm nhỏ
+    // của std::function nên parallelFor không cấp phát cho nó
+    struct StepArgs {
+        VecEnv& env;
+        const uint8_t* actions;
+        float* rewards;
+        uint8_t* dones;
+    } args = {env, actions, rewards, dones};
+    auto runBlock = [&args](size_t b) {
+        size_t begin = b * VEC_ENV_BLOCK;
+        size_t end = min(args.env.count, begin + VEC_ENV_BLOCK);
+        args.env.blockEnded[b] = stepRange(args.env, begin, end, args.actions, args.rewards, args.dones);
+    };
+    // Một khối thì chạy luôn, khỏi trả giá đồng bộ với pool
+    if (blocks <= 1 || env.pool->workerCount() <= 1) {
+        for (size_t b = 0; b < blocks; b++) runBlock(b);
+    } else {
+        parallelFor(*env.pool, blocks, runBlock);
+    }
+    for (uint64_t n : env.blockEnded) env.episodes += n;
+    env.steps += env.count;
+}
+
+void vecEnvObserve(const VecEnv& env, float* out) {
+    const float speedScale = 1.0f / (1 << TOWER_SPEED_SHIFT);
+    for (size_t i = 0; i < env.count; i++) {
+        int32_t u = env.phase[i];
+        int32_t xq = u <= env.range[i] ? u : env.period[i] - u;
+        float* o = out + i * VEC_ENV_OBS_SIZE;
+        o[0] = float(xq) / TOWER_FP_ONE;
+        o[1] = float(env.width[i]);
+        o[2] = u < env.range[i] ? 1.0f : -1.0f;
+        o[3] = env.speed[i] * speedScale;
+        o[4] = float(env.prevX[i]);
+        o[5] = float(env.prevW[i]);
+        o[6] = float(env.score[i]);
+    }
+}
+
+
+struct TcVecEnv {
+    VecEnv env;
+};
+
+TcVecEnv* tc_env_create(size_t count, int threads) {
+    TcVecEnv* h = new TcVecEnv;
+    initVecEnv(h->env, count, threads);
+    return h;
+}
+
+void tc_env_destroy(TcVecEnv* env) { delete env; }
+void tc_env_reset(TcVecEnv* env, uint64_t seed) { vecEnvReset(env->env, seed); }
+
+void tc_env_step(TcVecEnv* env, const uint8_t* actions, float* rewards, uint8_t* dones) {
+    vecEnvStep(env->env, actions, rewards, dones);
+}
+
+void tc_env_observe(const TcVecEnv* env, float* obs) { vecEnvObserve(env->env, obs); }
+int tc_env_obs_size(void) { return VEC_ENV_OBS_SIZE; }
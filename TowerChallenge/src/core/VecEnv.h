@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "JobPool.h"
+#include "Random.h"
+#include "TowerCore.h"
+
+// Môi trường học tăng cường chạy hàng nghìn ván độc lập trong một lần gọi.
+// Mỗi step là một tick mô phỏng: action 1 = thả tile đang chạy ngay đầu tick
+// (phần lẻ 0), 0 = chờ; sau đó mọi ván tiến một tick. Luật giống hệt
+// towerPlaceTileFixed + towerTick với cùng TowerRules (kiểm tra bằng
+// tools/env_bench --check).
+//
+// Trạng thái lưu dạng SoA (mỗi trường một mảng) để phần di chuyển và phần
+// overlap/perfect chạy bằng SIMD (SSE2) 4 ván một lượt; các ván được chia
+// khối cho JobPool. Ván kết thúc được reset tự động ở cùng step, observation
+// trả về là của ván mới. Luật chơi không có ngẫu nhiên nào ảnh hưởng tới
+// điểm, nên seed chỉ chọn số tick chờ ban đầu (no-op start) của mỗi ván để
+// các ván không chạy đồng bộ với nhau.
+
+const int VEC_ENV_OBS_SIZE = 7;       // xem vecEnvObserve
+const size_t VEC_ENV_BLOCK = 2048;    // số ván mỗi việc giao cho JobPool
+
+struct VecEnv {
+    size_t count = 0;
+    int tickHz = TOWER_TICK_HZ;
+    int32_t hzMinusOne = TOWER_TICK_HZ - 1;
+    TowerRules rules;
+
+    // Tile đang chạy (Q16); stepQ/stepR = (speed << 8) chia tickHz, tính sẵn
+    // để mỗi tick chỉ còn cộng và so sánh
+    std::vector<int32_t> phase, phaseRem, stepQ, stepR, range, period;
+    std::vector<int32_t> width, speed;
+    // Tile trên cùng của tháp (px)
+    std::vector<int32_t> prevX, prevW;
+    std::vector<int32_t> score, tiles;
+    std::vector<Pcg32> rng;
+
+    std::unique_ptr<JobPool> pool;
+    std::vector<uint64_t> blockEnded;   // số ván kết thúc của từng khối trong step, cấp một lần
+    uint64_t steps = 0;       // tổng env-step
+    uint64_t episodes = 0;    // số ván đã kết thúc
+};
+
+void initVecEnv(VecEnv& env, size_t count, int threads = 0, int tickHz = TOWER_TICK_HZ,
+                const TowerRules& rules = TowerRules());
+
+// Reset mọi ván; ván i dùng luồng ngẫu nhiên riêng (seed, i).
+void vecEnvReset(VecEnv& env, uint64_t seed);
+
+// actions[count] (0/1). rewards[count] = điểm cộng thêm, dones[count] = 1 nếu
+// ván vừa thua (và đã được reset). rewards/dones có thể là nullptr.
+void vecEnvStep(VecEnv& env, const uint8_t* actions, float* rewards, uint8_t* dones);
+
+// out[count * VEC_ENV_OBS_SIZE]: x tile đang chạy, bề rộng, hướng (+1/-1),
+// tốc độ (px/s), x và bề rộng tile trên cùng, điểm.
+void vecEnvObserve(const VecEnv& env, float* out);
+
+
+// Giao diện C cho các binding (Python ctypes...).
+extern "C" {
+struct TcVecEnv;
+TcVecEnv* tc_env_create(size_t count, int threads);
+void tc_env_destroy(TcVecEnv* env);
+void tc_env_reset(TcVecEnv* env, uint64_t seed);
+void tc_env_step(TcVecEnv* env, const uint8_t* actions, float* rewards, uint8_t* dones);
+void tc_env_observe(const TcVecEnv* env, float* obs);
+int tc_env_obs_size(void);
+}
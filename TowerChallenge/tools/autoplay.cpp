@@ -0,0 +1,79 @@
+// Cho bot (AutoPlayer) chơi headless bằng đúng luật của tower_core, để load
+// test và đo tốc độ tìm kiếm:
+//   autoplay [số ván] [--jitter tick] [--depth N] [--budget-ms ms] [--threads N]
+//            [--max-tiles N] [--save thư mục]
+// Với --save, mỗi ván được ghi thành replay để verify_replays kiểm tra lại.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#include "core/AutoPlayer.h"
+#include "core/Replay.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int games = 10;
+    size_t maxTiles = 500;       // bot chính xác có thể chơi mãi
+    const char* saveDir = nullptr;
+    AutoPlayerConfig config;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--jitter") == 0 && i + 1 < argc) config.jitterTicks = atof(argv[++i]);
+        else if (strcmp(argv[i], "--depth") == 0 && i + 1 < argc) config.maxDepth = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--budget-ms") == 0 && i + 1 < argc) config.budgetMs = atof(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) config.threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--max-tiles") == 0 && i + 1 < argc) maxTiles = size_t(atol(argv[++i]));
+        else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc) saveDir = argv[++i];
+        else games = atoi(argv[i]);
+    }
+    if (saveDir) {
+        error_code ec;
+        filesystem::create_directories(saveDir, ec);
+    }
+
+    AutoPlayer bot;
+    initAutoPlayer(bot, config, 12345);
+    static TowerCore core;
+    Replay replay;
+    long long totalScore = 0;
+    uint64_t ticks = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (int g = 0; g < games; g++) {
+        uint64_t seed = 1000 + uint64_t(g);
+        Pcg32 rng(seed);
+        towerReset(core, &rng, nullptr);
+        beginReplay(replay, seed, core.tickHz);
+        while (!core.gameOver && core.tiles.size() < maxTiles) {
+            AutoPlayerPlan plan;
+            if (!autoPlayerDecide(bot, core, plan)) break;
+            autoPlayerJitter(bot, core, plan);
+            while (core.tick < plan.tick) towerTick(core);
+            replayRecordDrop(replay, core, double(plan.fraction) / TOWER_FP_ONE);
+        }
+        finishReplay(replay, core);
+        totalScore += core.score;
+        ticks += core.tick;
+        if (saveDir && core.gameOver) {
+            string path = string(saveDir) + "/bot_" + to_string(seed) + ".tcr";
+            if (!saveReplay(path.c_str(), replay)) fprintf(stderr, "cannot write %s\n", path.c_str());
+        }
+        printf("game %d: score %d, %zu tiles%s\n", g, core.score, core.tiles.size(),
+               core.gameOver ? "" : " (stopped at --max-tiles)");
+    }
+    double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    const AutoPlayerStats& s = bot.stats;
+    printf("%d games in %.2f s, avg score %.1f, %.0fx real time\n", games, sec,
+           double(totalScore) / max(1, games), sec > 0 ? double(ticks) / TOWER_TICK_HZ / sec : 0.0);
+    printf("%llu decisions on %d threads: %.0f decisions/s, %.1f M evals/s, depth avg %.2f (min %d, max %d)\n",
+           (unsigned long long)s.decisions, bot.pool->workerCount(),
+           s.searchSeconds > 0 ? s.decisions / s.searchSeconds : 0.0,
+           s.searchSeconds > 0 ? s.nodes / s.searchSeconds / 1e6 : 0.0,
+           s.decisions ? double(s.depthSum) / s.decisions : 0.0, s.depthMin, s.depthMax);
+    return 0;
+}
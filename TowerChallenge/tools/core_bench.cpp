@@ -0,0 +1,42 @@
+// Benchmark headless cho tower_core: chơi nhiều ván với thời điểm thả ngẫu
+// nhiên, không cần cửa sổ hay thiết bị âm thanh.
+//   core_bench [số ván]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "core/Random.h"
+#include "core/TowerCore.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int games = argc > 1 ? atoi(argv[1]) : 100000;
+
+    Pcg32 rng(12345);
+    TowerCore core;
+    uint64_t ticks = 0, drops = 0;
+    long long totalScore = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (int g = 0; g < games; g++) {
+        towerReset(core, &rng, nullptr);
+        while (!core.gameOver) {
+            // Chờ ngẫu nhiên 0.25 - 2 giây rồi thả
+            int wait = TOWER_TICK_HZ / 4 + int(rng.next() % (TOWER_TICK_HZ * 7 / 4));
+            for (int i = 0; i < wait; i++) towerTick(core);
+            ticks += wait;
+            towerPlaceTile(core, (rng.next() % 1000) / 1000.0);
+            drops++;
+        }
+        totalScore += core.score;
+    }
+    double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    printf("%d games, %llu ticks, %llu drops in %.3f s\n", games,
+           (unsigned long long)ticks, (unsigned long long)drops, sec);
+    printf("%.2f M ticks/s, %.0f drops/s, avg score %.2f\n",
+           ticks / sec / 1e6, drops / sec, double(totalScore) / games);
+    return 0;
+}
@@ -0,0 +1,315 @@
+// Quét thông số độ khó bằng người chơi mô phỏng, chạy headless trên mọi nhân:
+//   difficulty_sweep [--initial 150,200,250] [--max 200,300] [--inc 1,2.5,5] [--tol 1,2,3]
+//                    [--players normal:25,normal:50,laplace:30:10] [--games N]
+//                    [--lead-ms 300] [--max-tiles N] [--threads N] [--csv tiền tố]
+// Tốc độ tính bằng px/s, tolerance bằng px. Mỗi người chơi là phân phối độ
+// lệch tay bấm (ms) quanh thời điểm tile thẳng hàng với tile dưới:
+//   normal:σ, uniform:a (±a), laplace:b (đuôi dài), thêm :bias để bấm trễ/sớm.
+// Người chơi nhắm lần thẳng hàng đầu tiên sau lead-ms kể từ khi tile xuất hiện.
+// Mọi bộ thông số dùng cùng dãy hạt giống nên so sánh được với nhau.
+// Với --csv, ghi thêm <tiền tố>_scores.csv (phân phối điểm) và
+// <tiền tố>_runs.csv (tỉ lệ còn sống theo số tile và theo giây).
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <string>
+#include <vector>
+
+#include "core/JobPool.h"
+#include "core/Random.h"
+#include "core/TowerCore.h"
+
+using namespace std;
+
+enum JitterKind { JITTER_NORMAL, JITTER_UNIFORM, JITTER_LAPLACE };
+
+struct PlayerModel {
+    string name;
+    JitterKind kind = JITTER_NORMAL;
+    double scaleMs = 0.0;
+    double biasMs = 0.0;
+};
+
+struct SweepResult {
+    vector<int> scores;
+    vector<int> tiles;        // số tile đã đặt
+    vector<double> seconds;   // thời gian chơi
+    vector<int> perfects;
+};
+
+const int SCORE_BUCKETS[] = {0, 1, 5, 10, 20, 50, 100, 200, 500, 1000};
+const int RUN_TILES[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000};
+const int RUN_SECONDS[] = {5, 10, 30, 60, 120, 300, 600};
+const int GAMES_PER_JOB = 64;
+
+
+static vector<double> parseList(const char* s) {
+    vector<double> out;
+    for (const char* p = s; *p;) {
+        char* end;
+        double v = strtod(p, &end);
+        if (end == p) break;
+        out.push_back(v);
+        p = *end == ',' ? end + 1 : end;
+    }
+    return out;
+}
+
+static bool parsePlayers(const char* s, vector<PlayerModel>& out) {
+    out.clear();
+    string all = s;
+    size_t pos = 0;
+    while (pos <= all.size()) {
+        size_t comma = all.find(',', pos);
+        string item = all.substr(pos, comma == string::npos ? string::npos : comma - pos);
+        pos = comma == string::npos ? all.size() + 1 : comma + 1;
+        if (item.empty()) continue;
+
+        PlayerModel m;
+        m.name = item;
+        char kind[16] = {};
+        if (sscanf(item.c_str(), "%15[a-z]:%lf:%lf", kind, &m.scaleMs, &m.biasMs) < 2) return false;
+        if (strcmp(kind, "normal") == 0) m.kind = JITTER_NORMAL;
+        else if (strcmp(kind, "uniform") == 0) m.kind = JITTER_UNIFORM;
+        else if (strcmp(kind, "laplace") == 0) m.kind = JITTER_LAPLACE;
+        else return false;
+        out.push_back(m);
+    }
+    return !out.empty();
+}
+
+static double uniform01(Pcg32& rng) { return (rng.nextU32() + 0.5) / 4294967296.0; }
+
+static double sampleJitterMs(const PlayerModel& m, Pcg32& rng) {
+    double u = uniform01(rng);
+    double z = 0.0;
+    switch (m.kind) {
+    case JITTER_NORMAL:
+        z = sqrt(-2.0 * log(u)) * cos(6.283185307179586 * uniform01(rng));
+        break;
+    case JITTER_UNIFORM:
+        z = 2.0 * u - 1.0;
+        break;
+    case JITTER_LAPLACE:
+        z = u < 0.5 ? log(2.0 * u) : -log(2.0 * (1.0 - u));
+        break;
+    }
+    return m.biasMs + z * m.scaleMs;
+}
+
+// Thời điểm (Q16 tick kể từ lúc tile xuất hiện) tile t thẳng hàng với targetX
+// lần đầu tiên không sớm hơn lead. Tile mới luôn bắt đầu ở x = 0, pha 0.
+static int64_t alignedAfter(const Tile& t, int tickHz, int targetX, int64_t lead) {
+    int64_t range = int64_t(TOWER_WIDTH - t.w) << TOWER_FP_SHIFT;
+    int64_t speed = int64_t(t.speed) << (TOWER_FP_SHIFT - TOWER_SPEED_SHIFT);   // Q16 px/s
+    if (range <= 0 || speed <= 0) return lead;
+    // Quãng đường (Q16 px) -> thời gian (Q16 tick)
+    auto when = [&](int64_t dist) { return dist * tickHz * TOWER_FP_ONE / speed; };
+    int64_t period = 2 * range;
+    int64_t cycle = max<int64_t>(1, when(period));
+    int64_t target = int64_t(targetX) << TOWER_FP_SHIFT;
+    int64_t best = INT64_MAX;
+    for (int64_t d : {target, period - target}) {
+        int64_t at = when(d);
+        if (at < lead) at += (lead - at + cycle - 1) / cycle * cycle;
+        best = min(best, at);
+    }
+    return best;
+}
+
+static void playGame(TowerCore& core, const TowerRules& rules, const PlayerModel& player, uint64_t seed,
+                     size_t maxTiles, int64_t lead, int* score, int* tiles, double* seconds, int* perfects) {
+    core.rules = rules;
+    Pcg32 rng(seed);
+    Pcg32 hand(seed, 0xB0B);
+    towerReset(core, &rng, nullptr);
+
+    double msToQ16 = core.tickHz / 1000.0 * TOWER_FP_ONE;
+    uint32_t lastFraction = 0;
+    int placed = 0, perfect = 0;
+    while (!core.gameOver && size_t(placed) < maxTiles) {
+        const Tile& curr = core.tiles.back();
+        const Tile& prev = core.tiles[core.tiles.size() - 2];
+        int64_t aim = alignedAfter(curr, core.tickHz, prev.x, lead);
+        int64_t when = max<int64_t>(0, aim + llround(sampleJitterMs(player, hand) * msToQ16));
+
+        // Tiến tới tick ngay trước lúc bấm, phần lẻ còn lại là fraction (< 1 tick)
+        towerAdvance(core, uint64_t(when >> TOWER_FP_SHIFT));
+        lastFraction = uint32_t(when & (TOWER_FP_ONE - 1));
+        int before = core.score;
+        if (!towerPlaceTileFixed(core, lastFraction)) break;
+        placed++;
+        perfect += core.score - before == PERFECT_BONUS;
+    }
+    *score = core.score;
+    *tiles = placed;
+    *seconds = (double(core.tick) + double(lastFraction) / TOWER_FP_ONE) / core.tickHz;
+    *perfects = perfect;
+}
+
+static double percentile(vector<int> v, double p) {
+    if (v.empty()) return 0.0;
+    sort(v.begin(), v.end());
+    return v[min(v.size() - 1, size_t(p * (v.size() - 1) + 0.5))];
+}
+
+static string rulesLabel(const TowerRules& r) {
+    char buf[96];
+    snprintf(buf, sizeof(buf), "%g,%g,%g,%d", r.initialSpeed / 256.0, r.maxSpeed / 256.0,
+             r.speedIncrement / 256.0, r.perfectTolerance);
+    return buf;
+}
+
+int main(int argc, char* argv[]) {
+    vector<double> initials = {150, 200, 250};
+    vector<double> maxes = {200, 300};
+    vector<double> incs = {1, 2.5, 5};
+    vector<double> tols = {1, 2, 3};
+    vector<PlayerModel> players;
+    parsePlayers("normal:25,normal:50,laplace:30:10", players);
+    int games = 2000;
+    double leadMs = 300;
+    size_t maxTiles = 1000;
+    int threads = 0;
+    const char* csv = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--initial") == 0 && i + 1 < argc) initials = parseList(argv[++i]);
+        else if (strcmp(argv[i], "--max") == 0 && i + 1 < argc) maxes = parseList(argv[++i]);
+        else if (strcmp(argv[i], "--inc") == 0 && i + 1 < argc) incs = parseList(argv[++i]);
+        else if (strcmp(argv[i], "--tol") == 0 && i + 1 < argc) tols = parseList(argv[++i]);
+        else if (strcmp(argv[i], "--players") == 0 && i + 1 < argc) {
+            if (!parsePlayers(argv[++i], players)) {
+                fprintf(stderr, "bad --players: %s\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--games") == 0 && i + 1 < argc) games = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--lead-ms") == 0 && i + 1 < argc) leadMs = atof(argv[++i]);
+        else if (strcmp(argv[i], "--max-tiles") == 0 && i + 1 < argc) maxTiles = size_t(atol(argv[++i]));
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) csv = argv[++i];
+        else {
+            fprintf(stderr, "unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    // Lưới thông số; bỏ các bộ có tốc độ tối đa nhỏ hơn tốc độ đầu
+    vector<TowerRules> grid;
+    for (double a : initials)
+        for (double m : maxes)
+            for (double inc : incs)
+                for (double tol : tols) {
+                    if (m < a || a <= 0) continue;
+                    TowerRules r;
+                    r.initialSpeed = int(lround(a * (1 << TOWER_SPEED_SHIFT)));
+                    r.maxSpeed = int(lround(m * (1 << TOWER_SPEED_SHIFT)));
+                    r.speedIncrement = int(lround(inc * (1 << TOWER_SPEED_SHIFT)));
+                    r.perfectTolerance = int(tol);
+                    grid.push_back(r);
+                }
+    if (grid.empty() || players.empty() || games <= 0) {
+        fprintf(stderr, "empty sweep\n");
+        return 1;
+    }
+
+    size_t cells = grid.size() * players.size();
+    vector<SweepResult> results(cells);
+    for (SweepResult& r : results) {
+        r.scores.resize(games);
+        r.tiles.resize(games);
+        r.seconds.resize(games);
+        r.perfects.resize(games);
+    }
+
+    JobPool pool(threads);
+    int64_t lead = llround(leadMs * TOWER_TICK_HZ / 1000.0 * TOWER_FP_ONE);
+    size_t jobsPerCell = (size_t(games) + GAMES_PER_JOB - 1) / GAMES_PER_JOB;
+    auto start = chrono::steady_clock::now();
+    parallelFor(pool, cells * jobsPerCell, [&](size_t job) {
+        size_t cell = job / jobsPerCell;
+        const TowerRules& rules = grid[cell / players.size()];
+        const PlayerModel& player = players[cell % players.size()];
+        SweepResult& r = results[cell];
+        // TowerCore lớn (cửa sổ tile nóng + bộ đệm lịch sử): mỗi việc dùng lại một cái
+        static thread_local TowerCore core;
+        int first = int(job % jobsPerCell) * GAMES_PER_JOB;
+        for (int g = first; g < min(games, first + GAMES_PER_JOB); g++) {
+            playGame(core, rules, player, 1000 + uint64_t(g), maxTiles, lead, &r.scores[g], &r.tiles[g],
+                     &r.seconds[g], &r.perfects[g]);
+        }
+    });
+    double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    FILE* scoresCsv = nullptr;
+    FILE* runsCsv = nullptr;
+    if (csv) {
+        scoresCsv = fopen((string(csv) + "_scores.csv").c_str(), "w");
+        runsCsv = fopen((string(csv) + "_runs.csv").c_str(), "w");
+        if (!scoresCsv || !runsCsv) {
+            fprintf(stderr, "cannot write %s_*.csv\n", csv);
+            return 1;
+        }
+        fprintf(scoresCsv, "initial,max,inc,tol,player,score_from,games\n");
+        fprintf(runsCsv, "initial,max,inc,tol,player,unit,at,alive\n");
+    }
+
+    printf("%-24s %-18s %7s %5s %5s %5s %6s %7s %8s %8s\n", "initial,max,inc,tol", "player", "mean", "p10",
+           "p50", "p90", "perf%", "tiles", "seconds", "alive@20");
+    uint64_t totalTiles = 0;
+    for (size_t cell = 0; cell < cells; cell++) {
+        const SweepResult& r = results[cell];
+        string label = rulesLabel(grid[cell / players.size()]);
+        const string& player = players[cell % players.size()].name;
+
+        double meanScore = 0, meanTiles = 0, meanSec = 0, perfects = 0;
+        int alive20 = 0;
+        for (int g = 0; g < games; g++) {
+            meanScore += r.scores[g];
+            meanTiles += r.tiles[g];
+            meanSec += r.seconds[g];
+            perfects += r.perfects[g];
+            alive20 += r.tiles[g] >= 20;
+        }
+        totalTiles += uint64_t(meanTiles);
+        printf("%-24s %-18s %7.1f %5.0f %5.0f %5.0f %6.1f %7.1f %8.1f %8.3f\n", label.c_str(), player.c_str(),
+               meanScore / games, percentile(r.scores, 0.1), percentile(r.scores, 0.5), percentile(r.scores, 0.9),
+               meanTiles > 0 ? 100.0 * perfects / meanTiles : 0.0, meanTiles / games, meanSec / games,
+               double(alive20) / games);
+
+        if (scoresCsv) {
+            const size_t n = sizeof(SCORE_BUCKETS) / sizeof(SCORE_BUCKETS[0]);
+            for (size_t b = 0; b < n; b++) {
+                int lo = SCORE_BUCKETS[b], hi = b + 1 < n ? SCORE_BUCKETS[b + 1] : INT32_MAX;
+                int count = 0;
+                for (int s : r.scores) count += s >= lo && s < hi;
+                fprintf(scoresCsv, "%s,%s,%d,%d\n", label.c_str(), player.c_str(), lo, count);
+            }
+        }
+        if (runsCsv) {
+            // Tỉ lệ ván còn sống (hoặc chạm max-tiles) khi đạt mốc
+            for (int at : RUN_TILES) {
+                int alive = 0;
+                for (int t : r.tiles) alive += t >= at;
+                fprintf(runsCsv, "%s,%s,tiles,%d,%.4f\n", label.c_str(), player.c_str(), at, double(alive) / games);
+            }
+            for (int at : RUN_SECONDS) {
+                int alive = 0;
+                for (double s : r.seconds) alive += s >= at;
+                fprintf(runsCsv, "%s,%s,seconds,%d,%.4f\n", label.c_str(), player.c_str(), at,
+                        double(alive) / games);
+            }
+        }
+    }
+    if (scoresCsv) fclose(scoresCsv);
+    if (runsCsv) fclose(runsCsv);
+
+    printf("%zu configs x %zu players x %d games (%llu tiles) on %d threads in %.2f s\n", grid.size(),
+           players.size(), games, (unsigned long long)totalTiles, pool.workerCount(), sec);
+    return 0;
+}
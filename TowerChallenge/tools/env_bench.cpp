@@ -0,0 +1,152 @@
+// Đo tốc độ môi trường học tăng cường (VecEnv) với chính sách ngẫu nhiên:
+//   env_bench [số ván song song] [--steps N] [--threads N] [--drop-rate p] [--check]
+// Với --check, mỗi ván được chơi lại song song trên TowerCore bằng cùng
+// action và so từng tick, để chắc bản SIMD khớp luật gốc; chạy một lần với
+// luật mặc định và một lần với CHECK_RULES (tốc độ tăng dần, tolerance khác).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "core/VecEnv.h"
+
+using namespace std;
+
+// Luật mặc định có tốc độ đầu = tốc độ tối đa nên không bao giờ tăng tốc
+static TowerRules checkRules() {
+    TowerRules r;
+    r.initialSpeed = 150 << TOWER_SPEED_SHIFT;
+    r.maxSpeed = 320 << TOWER_SPEED_SHIFT;
+    r.speedIncrement = 8 << TOWER_SPEED_SHIFT;
+    r.perfectTolerance = 4;
+    return r;
+}
+
+// Chạy lại ván i trên TowerCore tới khi ván đó kết thúc lần đầu
+static bool checkAgainstCore(size_t envs, int steps, double dropRate, const TowerRules& rules) {
+    const uint64_t seed = 777;
+    VecEnv env;
+    initVecEnv(env, envs, 1, TOWER_TICK_HZ, rules);
+    vecEnvReset(env, seed);
+
+    vector<Pcg32> coreRng(envs);
+    vector<TowerCore> cores(envs);
+    vector<bool> alive(envs, true);
+    for (size_t i = 0; i < envs; i++) {
+        coreRng[i].seed(seed);
+        cores[i].rules = rules;
+        towerReset(cores[i], &coreRng[i], nullptr);
+        // Cùng số tick chờ ban đầu như vecEnvReset
+        Pcg32 r(seed, i);
+        const Tile& t = cores[i].tiles.back();
+        uint32_t periodTicks = uint32_t(int64_t(2 * (TOWER_WIDTH - t.w)) * TOWER_TICK_HZ * TOWER_FP_ONE /
+                                        (int64_t(t.speed) << (TOWER_FP_SHIFT - TOWER_SPEED_SHIFT)));
+        uint32_t wait = r.nextU32() % (periodTicks + 1);
+        for (uint32_t k = 0; k < wait; k++) towerTick(cores[i]);
+    }
+
+    Pcg32 policy(99);
+    vector<uint8_t> actions(envs), dones(envs);
+    vector<float> rewards(envs), obs(envs * VEC_ENV_OBS_SIZE);
+    uint32_t threshold = uint32_t(dropRate * 4294967295.0);
+    for (int s = 0; s < steps; s++) {
+        // Nửa số ván thả khi tile gần thẳng hàng để có cả perfect và ván dài
+        vecEnvObserve(env, obs.data());
+        for (size_t i = 0; i < envs; i++) {
+            const float* o = obs.data() + i * VEC_ENV_OBS_SIZE;
+            bool aligned = i % 2 == 0 && o[0] >= o[4] - 2 && o[0] <= o[4] + 2;
+            actions[i] = aligned || policy.nextU32() < threshold;
+        }
+        vecEnvStep(env, actions.data(), rewards.data(), dones.data());
+
+        for (size_t i = 0; i < envs; i++) {
+            if (!alive[i]) continue;
+            TowerCore& core = cores[i];
+            int before = core.score;
+            if (actions[i]) towerPlaceTileFixed(core, 0);
+            towerTick(core);
+            if (bool(dones[i]) != core.gameOver || rewards[i] != float(core.score - before)) {
+                printf("env %zu step %d: done %d/%d reward %.0f/%d\n", i, s, dones[i], core.gameOver,
+                       rewards[i], core.score - before);
+                return false;
+            }
+            if (core.gameOver) {
+                alive[i] = false;
+                continue;
+            }
+            const Tile& t = core.tiles.back();
+            const Tile& prev = core.tiles[core.tiles.size() - 2];
+            if (t.phase != env.phase[i] || int32_t(t.phaseRem) != env.phaseRem[i] || t.w != env.width[i] ||
+                t.speed != env.speed[i] || prev.x != env.prevX[i] || prev.w != env.prevW[i] ||
+                core.score != env.score[i]) {
+                printf("env %zu step %d: state differs from TowerCore\n", i, s);
+                return false;
+            }
+        }
+    }
+    size_t finished = 0;
+    int best = 0;
+    int fastest = 0;
+    for (size_t i = 0; i < envs; i++) {
+        finished += !alive[i];
+        best = max(best, cores[i].score);
+        fastest = max(fastest, env.speed[i]);
+    }
+    printf("check ok: %zu envs x %d steps, %zu games finished, best score %d, top speed %d px/s\n", envs,
+           steps, finished, best, fastest >> TOWER_SPEED_SHIFT);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    size_t envs = 4096;
+    int steps = 20000;
+    int threads = 0;
+    double dropRate = 1.0 / 150;   // trung bình thả mỗi ~0.6 giây
+    bool check = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc) steps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--drop-rate") == 0 && i + 1 < argc) dropRate = atof(argv[++i]);
+        else if (strcmp(argv[i], "--check") == 0) check = true;
+        else envs = size_t(atol(argv[i]));
+    }
+    if (check) {
+        bool ok = checkAgainstCore(envs, steps, dropRate, TowerRules()) &&
+                  checkAgainstCore(envs, steps, dropRate, checkRules());
+        return ok ? 0 : 1;
+    }
+
+    VecEnv env;
+    initVecEnv(env, envs, threads);
+    vecEnvReset(env, 12345);
+
+    // Action ngẫu nhiên sinh trước để chỉ đo môi trường
+    const int ACTION_ROWS = 61;
+    vector<uint8_t> actions(envs * ACTION_ROWS);
+    Pcg32 policy(99);
+    uint32_t threshold = uint32_t(dropRate * 4294967295.0);
+    for (uint8_t& a : actions) a = policy.nextU32() < threshold;
+    vector<float> rewards(envs), obs(envs * VEC_ENV_OBS_SIZE);
+    vector<uint8_t> dones(envs);
+
+    double reward = 0.0;
+    auto start = chrono::steady_clock::now();
+    for (int s = 0; s < steps; s++) {
+        vecEnvStep(env, actions.data() + envs * (s % ACTION_ROWS), rewards.data(), dones.data());
+        reward += rewards[s % envs];
+    }
+    double stepSec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (int s = 0; s < 100; s++) vecEnvObserve(env, obs.data());
+    double obsSec = chrono::duration<double>(chrono::steady_clock::now() - start).count() / 100;
+
+    printf("%zu envs x %d steps on %d threads in %.3f s (%llu episodes finished)\n", envs, steps,
+           env.pool->workerCount(), stepSec, (unsigned long long)env.episodes);
+    printf("%.1f M env-steps/s, observe %.1f us per call (sampled reward %.0f)\n",
+           env.steps / stepSec / 1e6, obsSec * 1e6, reward);
+    return 0;
+}
@@ -0,0 +1,186 @@
+// Đóng gói assets/ thành một file nhị phân để game không phải giải mã PNG/JPEG
+// và MP3 lúc khởi động:
+//   pack_assets [thư mục assets] [file đầu ra]
+// Mặc định đọc assets/ và ghi assets/assets.pack. Ảnh được thu nhỏ sẵn về kích
+// thước vẽ (ImageScale), các ảnh UI nhỏ được ghép thành một atlas (UiAtlas),
+// hiệu ứng âm thanh được giải mã thành PCM theo đúng thông số Mix_OpenAudio
+// của game.
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "AssetPack.h"
+#include "ImageScale.h"
+#include "UiAtlas.h"
+
+using namespace std;
+
+// Kích thước vẽ trong Game.cpp (cửa sổ 450x600)
+struct ImageSpec {
+    const char* name;
+    int width;
+    int height;
+};
+
+const ImageSpec PACK_IMAGES[] = {
+    {"images/background.png", 450, 600},
+    {"images/menu_bg.png", 450, 600},
+};
+
+const char* PACK_SOUNDS[] = {
+    "audio/block_place.mp3",
+    "audio/block_perfect.mp3",
+};
+
+// Phải khớp Mix_OpenAudio trong initSDL; runtime kiểm tra lại và giải mã
+// file gốc nếu khác.
+const int PACK_AUDIO_FREQ = 44100;
+const int PACK_AUDIO_CHANNELS = 2;
+
+
+struct PackItem {
+    PackEntry entry;
+    vector<uint8_t> data;
+};
+
+static void storeSurface(SDL_Surface* surf, PackItem& item) {
+    item.data.resize(size_t(surf->pitch) * surf->h);
+    memcpy(item.data.data(), surf->pixels, item.data.size());
+    item.entry.type = PACK_IMAGE;
+    item.entry.width = uint32_t(surf->w);
+    item.entry.height = uint32_t(surf->h);
+    item.entry.pitch = uint32_t(surf->pitch);
+}
+
+static bool packImage(const string& dir, const ImageSpec& spec, PackItem& item) {
+    string path = dir + "/" + spec.name;
+    SDL_Surface* surf = loadImageScaled(path.c_str(), spec.width, spec.height);
+    if (!surf) {
+        fprintf(stderr, "%s: %s\n", path.c_str(), IMG_GetError());
+        return false;
+    }
+    storeSurface(surf, item);
+    SDL_FreeSurface(surf);
+    printf("  %-26s -> %dx%d\n", spec.name, spec.width, spec.height);
+    return true;
+}
+
+static bool packUiAtlas(const string& dir, PackItem& item) {
+    SDL_Surface* surf = buildUiAtlasSurface(dir.c_str());
+    if (!surf) return false;
+    storeSurface(surf, item);
+    printf("  %-26s -> %dx%d (%d sprites)\n", UI_ATLAS_NAME, surf->w, surf->h, int(UI_SPRITE_COUNT));
+    SDL_FreeSurface(surf);
+    return true;
+}
+
+static bool packSound(const string& dir, const char* name, PackItem& item) {
+    string path = dir + "/" + name;
+    Mix_Chunk* chunk = Mix_LoadWAV(path.c_str());
+    if (!chunk) {
+        fprintf(stderr, "%s: %s\n", path.c_str(), Mix_GetError());
+        return false;
+    }
+    item.data.assign(chunk->abuf, chunk->abuf + chunk->alen);
+    Mix_FreeChunk(chunk);
+
+    int freq, channels;
+    Uint16 format;
+    Mix_QuerySpec(&freq, &format, &channels);
+    item.entry.type = PACK_PCM;
+    item.entry.freq = uint32_t(freq);
+    item.entry.format = format;
+    item.entry.channels = uint16_t(channels);
+    printf("  %-26s %u bytes PCM\n", name, unsigned(item.data.size()));
+    return true;
+}
+
+
+int main(int argc, char* argv[]) {
+    string dir = argc > 1 ? argv[1] : "assets";
+    string outPath = argc > 2 ? argv[2] : dir + "/assets.pack";
+
+    // Không cần thiết bị âm thanh thật, chỉ cần bộ giải mã của mixer
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+    if (SDL_Init(SDL_INIT_AUDIO) != 0) {
+        fprintf(stderr, "SDL_Init: %s\n", SDL_GetError());
+        return 1;
+    }
+    IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG);
+    Mix_Init(MIX_INIT_MP3);
+    if (Mix_OpenAudio(PACK_AUDIO_FREQ, MIX_DEFAULT_FORMAT, PACK_AUDIO_CHANNELS, 2048) < 0) {
+        fprintf(stderr, "Mix_OpenAudio: %s\n", Mix_GetError());
+        return 1;
+    }
+
+    vector<PackItem> items;
+    bool ok = true;
+    for (const ImageSpec& spec : PACK_IMAGES) {
+        PackItem item = {};
+        if (!packImage(dir, spec, item)) { ok = false; continue; }
+        strncpy(item.entry.name, spec.name, ASSET_PACK_NAME_LEN - 1);
+        items.push_back(move(item));
+    }
+    {
+        PackItem item = {};
+        if (packUiAtlas(dir, item)) {
+            strncpy(item.entry.name, UI_ATLAS_NAME, ASSET_PACK_NAME_LEN - 1);
+            items.push_back(move(item));
+        } else {
+            ok = false;
+        }
+    }
+    for (const char* name : PACK_SOUNDS) {
+        PackItem item = {};
+        if (!packSound(dir, name, item)) { ok = false; continue; }
+        strncpy(item.entry.name, name, ASSET_PACK_NAME_LEN - 1);
+        items.push_back(move(item));
+    }
+    Mix_CloseAudio();
+    Mix_Quit();
+    IMG_Quit();
+    SDL_Quit();
+    if (!ok) return 1;
+
+    // Bố cục: header, bảng mục, rồi dữ liệu căn ASSET_PACK_ALIGN
+    PackHeader header = {};
+    memcpy(header.magic, ASSET_PACK_MAGIC, 4);
+    header.version = ASSET_PACK_VERSION;
+    header.entryCount = uint32_t(items.size());
+    uint64_t offset = sizeof(PackHeader) + items.size() * sizeof(PackEntry);
+    for (PackItem& item : items) {
+        offset = (offset + ASSET_PACK_ALIGN - 1) / ASSET_PACK_ALIGN * ASSET_PACK_ALIGN;
+        item.entry.offset = offset;
+        item.entry.size = item.data.size();
+        offset += item.data.size();
+    }
+
+    FILE* f = fopen(outPath.c_str(), "wb");
+    if (!f) {
+        fprintf(stderr, "Cannot write %s\n", outPath.c_str());
+        return 1;
+    }
+    fwrite(&header, sizeof(header), 1, f);
+    for (const PackItem& item : items) fwrite(&item.entry, sizeof(PackEntry), 1, f);
+    for (const PackItem& item : items) {
+        static const char zeros[ASSET_PACK_ALIGN] = {};
+        long pos = ftell(f);
+        fwrite(zeros, 1, size_t(item.entry.offset - uint64_t(pos)), f);
+        fwrite(item.data.data(), 1, item.data.size(), f);
+    }
+    bool written = ferror(f) == 0;
+    fclose(f);
+    if (!written) {
+        fprintf(stderr, "Write error on %s\n", outPath.c_str());
+        return 1;
+    }
+    printf("%s: %u entries, %llu bytes\n", outPath.c_str(), unsigned(items.size()),
+           (unsigned long long)offset);
+    return 0;
+}
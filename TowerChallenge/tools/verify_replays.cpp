@@ -0,0 +1,95 @@
+// Kiểm tra top score: chạy lại mọi file replay trong một thư mục bằng đúng
+// luật của tower_core, song song trên tất cả các nhân.
+//   verify_replays <thư mục> [--threads N] [--quiet]
+// Trả về 0 nếu mọi replay khớp với kết quả đã ghi, 2 nếu không có replay nào.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "core/JobPool.h"
+#include "core/Replay.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+struct VerifyResult {
+    bool loaded = false;
+    bool passed = false;
+    const char* error = nullptr;   // lý do loadReplay từ chối
+    int claimedScore = 0;
+    ReplayResult result;
+};
+
+int main(int argc, char* argv[]) {
+    const char* dir = nullptr;
+    int threads = 0;
+    bool quiet = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--quiet") == 0) quiet = true;
+        else dir = argv[i];
+    }
+    if (!dir) {
+        fprintf(stderr, "usage: %s <replay dir> [--threads N] [--quiet]\n", argv[0]);
+        return 2;
+    }
+
+    vector<string> files;
+    error_code ec;
+    for (const fs::directory_entry& entry : fs::directory_iterator(dir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".tcr") {
+            files.push_back(entry.path().string());
+        }
+    }
+    if (ec) {
+        fprintf(stderr, "cannot read %s: %s\n", dir, ec.message().c_str());
+        return 2;
+    }
+    if (files.empty()) {
+        // Trỏ nhầm thư mục thì CI không được coi là đạt
+        fprintf(stderr, "no .tcr replays in %s\n", dir);
+        return 2;
+    }
+    sort(files.begin(), files.end());
+
+    vector<VerifyResult> results(files.size());
+    JobPool pool(threads);
+
+    auto start = chrono::steady_clock::now();
+    parallelFor(pool, files.size(), [&](size_t i) {
+        Replay replay;
+        VerifyResult& r = results[i];
+        r.loaded = loadReplay(files[i].c_str(), replay, &r.error);
+        if (!r.loaded) return;
+        r.claimedScore = replay.finalScore;
+        r.result = runReplay(replay);
+        r.passed = r.result.gameOver && replayMatches(replay, r.result);
+    });
+    double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t passed = 0;
+    double simSeconds = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+        const VerifyResult& r = results[i];
+        if (r.passed) passed++;
+        simSeconds += double(r.result.ticks) / TOWER_TICK_HZ;   // loadReplay chỉ nhận tần số chuẩn
+        if (quiet && r.passed) continue;
+        if (!r.loaded) {
+            printf("FAIL  %s  (%s)\n", files[i].c_str(), r.error);
+        } else {
+            printf("%s  %s  claimed %d, replayed %d\n", r.passed ? "PASS" : "FAIL",
+                   files[i].c_str(), r.claimedScore, r.result.score);
+        }
+    }
+
+    printf("%zu/%zu passed on %d threads in %.3f s: %.0f replays/s, %.0fx real time\n",
+           passed, files.size(), pool.workerCount(), sec,
+           sec > 0 ? files.size() / sec : 0.0, sec > 0 ? simSeconds / sec : 0.0);
+    return passed == files.size() ? 0 : 1;
+}